@@ -44,6 +44,7 @@ function(myproject_setup_dependencies)
     endif()
   endif()
   find_package(OpenGL REQUIRED)
+  find_package(Threads REQUIRED)
   if(NOT imgui)
     # ImGui
     cpmaddpackage(
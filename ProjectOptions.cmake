@@ -89,6 +89,10 @@ macro(myproject_setup_options)
 
   option(myproject_BUILD_FUZZ_TESTS "Enable fuzz testing executable" ${DEFAULT_FUZZER})
 
+  # Development mode: read glsl/ at runtime instead of embedding it, so shader
+  # edits need no rebuild
+  option(myproject_LOAD_SHADERS_FROM_DISK "Load shaders from the source tree at runtime" OFF)
+
 endmacro()
 
 macro(myproject_global_options)
@@ -0,0 +1,88 @@
+# Bakes every *.glsl file of a directory into a generated header of
+# constexpr std::string_views, so the executable needs no shader files at
+# runtime. The header is regenerated whenever a shader changes.
+#
+# This file is also the generator itself, run in script mode with DIRECTORY
+# and OUTPUT defined.
+
+if(CMAKE_SCRIPT_MODE_FILE)
+  file(GLOB shader_files "${DIRECTORY}/*.glsl")
+  list(SORT shader_files)
+
+  set(arrays "")
+  set(entries "")
+  set(index 0)
+  foreach(shader_file IN LISTS shader_files)
+    get_filename_component(shader_name "${shader_file}" NAME)
+    # Hex escapes survive any character the source may contain, including
+    # sequences that would end a raw string literal
+    file(READ "${shader_file}" content HEX)
+    string(
+      REGEX
+      REPLACE "([0-9a-f][0-9a-f])"
+              "'\\\\x\\1', "
+              content
+              "${content}")
+    string(APPEND arrays "  inline constexpr char kShader${index}[] = { ${content}'\\0' };\n")
+    string(APPEND entries
+           "  EmbeddedShader{ \"${shader_name}\", { _impl::kShader${index}, sizeof(_impl::kShader${index}) - 1 } },\n")
+    math(EXPR index "${index} + 1")
+  endforeach()
+
+  set(header
+      "// Generated by cmake/EmbedShaders.cmake from ${DIRECTORY}; do not edit
+#ifndef MYPROJECT_SHADERS_HPP
+#define MYPROJECT_SHADERS_HPP
+
+#include <array>
+#include <optional>
+#include <string_view>
+
+namespace myproject::shaders {
+struct EmbeddedShader
+{
+  std::string_view Name;
+  // Null terminated, the terminator is not part of the view
+  std::string_view Source;
+};
+
+namespace _impl {
+${arrays}}// namespace _impl
+
+inline constexpr std::array<EmbeddedShader, ${index}> kShaders{
+${entries}};
+
+// Looks a shader up by its file name, e.g. \"redFragmentShader.frag.glsl\"
+constexpr auto FindShader(std::string_view name) noexcept -> std::optional<std::string_view>
+{
+  for (auto const &Shader : kShaders) {
+    if (Shader.Name == name) { return Shader.Source; }
+  }
+  return std::nullopt;
+}
+}// namespace myproject::shaders
+
+#endif
+")
+  # Leave the header untouched when nothing changed to avoid rebuilds
+  file(WRITE "${OUTPUT}.tmp" "${header}")
+  file(COPY_FILE "${OUTPUT}.tmp" "${OUTPUT}" ONLY_IF_DIFFERENT)
+  file(REMOVE "${OUTPUT}.tmp")
+  return()
+endif()
+
+set(_MYPROJECT_EMBED_SHADERS_SCRIPT "${CMAKE_CURRENT_LIST_FILE}")
+
+# Generates internal_use_only/shaders.hpp for target from the shaders in
+# directory
+function(myproject_embed_shaders target directory)
+  file(GLOB shader_files CONFIGURE_DEPENDS "${directory}/*.glsl")
+  set(output "${CMAKE_BINARY_DIR}/configured_files/include/internal_use_only/shaders.hpp")
+  add_custom_command(
+    OUTPUT "${output}"
+    COMMAND ${CMAKE_COMMAND} "-DDIRECTORY=${directory}" "-DOUTPUT=${output}" -P "${_MYPROJECT_EMBED_SHADERS_SCRIPT}"
+    DEPENDS ${shader_files} "${_MYPROJECT_EMBED_SHADERS_SCRIPT}"
+    COMMENT "Embedding shaders from ${directory}"
+    VERBATIM)
+  target_sources(${target} PRIVATE "${output}")
+endfunction()
@@ -0,0 +1,132 @@
+#pragma once
+#include <glad/glad.h>//
+//
+#include <cstddef>
+#include <map>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace renderer::gl {
+
+struct ArenaStatistics
+{
+  std::size_t Capacity{};
+  std::size_t Used{};
+  std::size_t Allocations{};
+  std::size_t FreeBlocks{};
+  std::size_t LargestFreeBlock{};
+
+  constexpr auto operator+=(ArenaStatistics const &other) noexcept
+    -> ArenaStatistics &
+  {
+    Capacity += other.Capacity;
+    Used += other.Used;
+    Allocations += other.Allocations;
+    FreeBlocks += other.FreeBlocks;
+    LargestFreeBlock = LargestFreeBlock > other.LargestFreeBlock
+                         ? LargestFreeBlock
+                         : other.LargestFreeBlock;
+    return *this;
+  }
+  // Share of the free bytes outside the largest free block: 0 when all free
+  // space is one block, close to 1 when it is scattered in small gaps
+  [[nodiscard]] constexpr auto GetFragmentation() const noexcept -> double
+  {
+    auto const Free = Capacity - Used;
+    if (Free == 0) { return 0.0; }
+    return 1.0
+           - static_cast<double>(LargestFreeBlock) / static_cast<double>(Free);
+  }
+};
+
+// Free-list allocator over the byte range [0, capacity). Free blocks are
+// kept sorted by offset so freed neighbours merge back into one block;
+// allocation picks the smallest block that fits, which keeps large blocks
+// intact for large requests.
+class RangeAllocator
+{
+  std::size_t m_Capacity{};
+  std::size_t m_Used{};
+  std::size_t m_Allocations{};
+  // Offset to size of every free block
+  std::map<std::size_t, std::size_t> m_FreeBlocks;
+
+public:
+  explicit RangeAllocator(std::size_t capacity);
+
+  // Offset of size bytes aligned to alignment (a power of two), or nothing
+  // when no free block is large enough
+  [[nodiscard]] auto Allocate(std::size_t size, std::size_t alignment)
+    -> std::optional<std::size_t>;
+  // Returns a block from Allocate, with the same size
+  void Free(std::size_t offset, std::size_t size);
+
+  [[nodiscard]] auto GetCapacity() const noexcept -> std::size_t
+  {
+    return m_Capacity;
+  }
+  [[nodiscard]] auto GetStatistics() const noexcept -> ArenaStatistics;
+};
+
+// Sub-range of one of a BufferArena's buffers
+struct BufferAllocation
+{
+  GLuint Buffer{};
+  GLintptr Offset{};
+  GLsizeiptr Size{};
+
+  constexpr auto operator==(BufferAllocation const &) const -> bool = default;
+};
+
+// Hands out aligned ranges of a few large immutable buffers, so static
+// geometry such as lens outlines and plot axes shares buffer objects
+// instead of creating one per object. Data rewritten every frame belongs in
+// a StreamingBuffer instead.
+//
+// A new page is created when no existing one has room; requests larger
+// than the page size get a page of their own.
+class BufferArena
+{
+  struct Page
+  {
+    GLuint Buffer{};
+    RangeAllocator Ranges;
+  };
+  std::size_t m_PageSize{};
+  GLbitfield m_StorageFlags{};
+  std::vector<Page> m_Pages;
+
+  void Release() noexcept;
+
+public:
+  // Satisfies the offset alignment of vertex, uniform and storage buffers
+  static constexpr std::size_t kDefaultAlignment = 256;
+
+  explicit BufferArena(std::size_t page_size,
+    GLbitfield storage_flags = GL_DYNAMIC_STORAGE_BIT);
+  BufferArena(BufferArena const &) = delete;
+  BufferArena(BufferArena &&other) noexcept;
+  auto operator=(BufferArena const &) -> BufferArena & = delete;
+  auto operator=(BufferArena &&other) noexcept -> BufferArena &;
+  ~BufferArena() { Release(); }
+
+  [[nodiscard]] auto Allocate(std::size_t size,
+    std::size_t alignment = kDefaultAlignment) -> BufferAllocation;
+  // Allocates and fills a range in one call; needs GL_DYNAMIC_STORAGE_BIT
+  [[nodiscard]] auto Allocate(std::span<std::byte const> data,
+    std::size_t alignment = kDefaultAlignment) -> BufferAllocation;
+  void Free(BufferAllocation const &allocation);
+  // Writes data at offset within allocation; needs GL_DYNAMIC_STORAGE_BIT
+  static void Upload(BufferAllocation const &allocation,
+    std::span<std::byte const> data,
+    GLintptr offset = 0) noexcept;
+
+  [[nodiscard]] auto GetPageCount() const noexcept -> std::size_t
+  {
+    return m_Pages.size();
+  }
+  // Totals over all pages; LargestFreeBlock is the largest of any page
+  [[nodiscard]] auto GetStatistics() const noexcept -> ArenaStatistics;
+};
+}// namespace renderer::gl
@@ -0,0 +1,169 @@
+#pragma once
+#include <glad/glad.h>//
+//
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <renderer/buffer/vertexLayout.hpp>
+#include <renderer/colour/colour.hpp>
+#include <renderer/point/point.hpp>
+#include <renderer/vector/vector.hpp>
+#include <span>
+#include <tuple>
+
+// Smaller vertex formats for large ray and point datasets. Positions are
+// stored as half floats or 16 bit normalised integers and colours as
+// normalised bytes; VertexLayout reads them back as floats.
+namespace renderer::gl {
+
+// IEEE 754 binary16, read as GL_HALF_FLOAT. Exact for integers up to 2048
+// and about three significant decimal digits in general.
+struct Half
+{
+  std::uint16_t Bits{};
+
+  static constexpr GLenum kComponentType = GL_HALF_FLOAT;
+  static constexpr bool kNormalised = false;
+  constexpr auto operator==(Half const &) const -> bool = default;
+};
+
+// Signed value in [-1, 1] with 16 bits of precision, read as GL_SHORT
+struct Snorm16
+{
+  std::int16_t Value{};
+
+  static constexpr GLenum kComponentType = GL_SHORT;
+  static constexpr bool kNormalised = true;
+  constexpr auto operator==(Snorm16 const &) const -> bool = default;
+};
+
+// Unsigned value in [0, 1] with 8 bits of precision, read as
+// GL_UNSIGNED_BYTE
+struct Unorm8
+{
+  std::uint8_t Value{};
+
+  static constexpr GLenum kComponentType = GL_UNSIGNED_BYTE;
+  static constexpr bool kNormalised = true;
+  constexpr auto operator==(Unorm8 const &) const -> bool = default;
+};
+
+// Rounds to the nearest half, ties to even, exactly like the F16C
+// instructions: out of range values become infinities and NaNs stay NaNs
+constexpr auto ToHalf(float value) noexcept -> Half
+{
+  auto const Bits = std::bit_cast<std::uint32_t>(value);
+  auto const Sign = static_cast<std::uint16_t>((Bits >> 16U) & 0x8000U);
+  auto const Exponent = static_cast<int>((Bits >> 23U) & 0xFFU);
+  auto const Mantissa = Bits & 0x7F'FFFFU;
+  if (Exponent == 0xFF) {
+    // Infinity, or a quieted NaN keeping the top of its payload
+    auto const Payload = Mantissa == 0 ? 0U : 0x200U | (Mantissa >> 13U);
+    return { static_cast<std::uint16_t>(Sign | 0x7C00U | Payload) };
+  }
+  auto RoundToNearestEven = [](std::uint32_t bits, unsigned shift) {
+    auto const Kept = bits >> shift;
+    auto const Dropped = bits & ((1U << shift) - 1U);
+    auto const Halfway = 1U << (shift - 1U);
+    return Kept
+           + ((Dropped > Halfway || (Dropped == Halfway && (Kept & 1U) != 0))
+                 ? 1U
+                 : 0U);
+  };
+  auto const HalfExponent = Exponent - 127 + 15;
+  if (HalfExponent >= 0x1F) {
+    return { static_cast<std::uint16_t>(Sign | 0x7C00U) };
+  }
+  if (HalfExponent <= 0) {
+    // Subnormal half; anything below half the smallest one rounds to zero
+    if (HalfExponent < -10) { return { Sign }; }
+    auto const Shift = static_cast<unsigned>(14 - HalfExponent);
+    return { static_cast<std::uint16_t>(
+      Sign | RoundToNearestEven(Mantissa | 0x80'0000U, Shift)) };
+  }
+  // A carry out of the mantissa correctly bumps the exponent, up to infinity
+  auto const Rounded = RoundToNearestEven(
+    (static_cast<std::uint32_t>(HalfExponent) << 23U) | Mantissa, 13U);
+  return { static_cast<std::uint16_t>(Sign | Rounded) };
+}
+
+constexpr auto ToFloat(Half value) noexcept -> float
+{
+  auto const Sign = static_cast<std::uint32_t>(value.Bits & 0x8000U) << 16U;
+  auto const Exponent = (value.Bits >> 10U) & 0x1FU;
+  auto Mantissa = static_cast<std::uint32_t>(value.Bits & 0x3FFU);
+  if (Exponent == 0x1F) {
+    // Infinity, or a NaN that is quieted like ToHalf does
+    auto const Quiet = Mantissa == 0 ? 0U : 0x40'0000U;
+    return std::bit_cast<float>(
+      Sign | 0x7F80'0000U | Quiet | (Mantissa << 13U));
+  }
+  if (Exponent == 0) {
+    if (Mantissa == 0) { return std::bit_cast<float>(Sign); }
+    // Subnormal half: normalise into a float exponent
+    std::uint32_t Shift = 0;
+    while ((Mantissa & 0x400U) == 0) {
+      Mantissa <<= 1U;
+      ++Shift;
+    }
+    return std::bit_cast<float>(Sign | ((113U - Shift) << 23U)
+                                | ((Mantissa & 0x3FFU) << 13U));
+  }
+  return std::bit_cast<float>(
+    Sign | ((Exponent + 112U) << 23U) | (Mantissa << 13U));
+}
+
+// Clamps to [-1, 1] and rounds to the nearest step, as GL expects for
+// normalised signed integers
+constexpr auto ToSnorm16(float value) noexcept -> Snorm16
+{
+  constexpr float kScale = 32767.0F;
+  auto const Scaled = std::clamp(value, -1.0F, 1.0F) * kScale;
+  return { static_cast<std::int16_t>(Scaled < 0.0F ? Scaled - 0.5F
+                                                   : Scaled + 0.5F) };
+}
+
+// A renderer::Point in 8 (2D) or 12 (3D) bytes instead of 12 or 16 with
+// float positions. Three dimensional positions are padded to four
+// components, keeping every attribute four byte aligned; the padding
+// reads as w = 1. Colours gain an opaque alpha for the same reason.
+template<std::size_t Dimension, typename Component = Half>
+  requires((Dimension == 2 || Dimension == 3)
+           && (std::same_as<Component, Half>
+               || std::same_as<Component, Snorm16>))
+struct CompactPoint
+{
+  static constexpr std::size_t kStoredDimension = Dimension == 3 ? 4 : 2;
+  renderer::Vector<Component, kStoredDimension> Position;
+  renderer::Vector<Unorm8, 4> Colour;
+};
+template<typename Component = Half>
+using CompactPoint2 = CompactPoint<2, Component>;
+template<typename Component = Half>
+using CompactPoint3 = CompactPoint<3, Component>;
+
+template<std::size_t Dimension, typename Component>
+struct VertexMembers<CompactPoint<Dimension, Component>>
+{
+  static constexpr std::tuple kList{
+    &CompactPoint<Dimension, Component>::Position,
+    &CompactPoint<Dimension, Component>::Colour
+  };
+};
+
+// Converts points to half float positions. Uses the F16C instructions when
+// the processor has them and is bit identical to ToHalf either way.
+// destination must be at least as long as source.
+void PackPoints(std::span<renderer::Point2<float> const> source,
+  std::span<CompactPoint2<Half>> destination) noexcept;
+void PackPoints(std::span<renderer::Point3<float> const> source,
+  std::span<CompactPoint3<Half>> destination) noexcept;
+// Converts points whose coordinates are already within [-1, 1], such as
+// clip space positions or directions
+void PackPoints(std::span<renderer::Point2<float> const> source,
+  std::span<CompactPoint2<Snorm16>> destination) noexcept;
+void PackPoints(std::span<renderer::Point3<float> const> source,
+  std::span<CompactPoint3<Snorm16>> destination) noexcept;
+}// namespace renderer::gl
@@ -0,0 +1,88 @@
+#pragma once
+#include <glad/glad.h>//
+//
+#include <cstddef>
+#include <renderer/utils/frameStatistics.hpp>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace renderer::gl {
+
+// Buffer for data rewritten every frame, such as ray segments and plot
+// vertices. The immutable store is mapped once (persistent and coherent) and
+// split into regions used round-robin: the CPU fills one region while the
+// GPU still reads the ones submitted before it, and a fence per region only
+// makes the CPU wait if it laps the GPU.
+//
+//   auto Vertices = Stream.BeginRegion<RayVertex>();
+//   ...write Vertices...
+//   glVertexArrayVertexBuffer(vao, 0, Stream.GetBufferID(),
+//     Stream.GetRegionOffset(), sizeof(RayVertex));
+//   glDrawArrays(...);
+//   Stream.EndRegion();
+class StreamingBuffer
+{
+  GLuint m_BufferID{};
+  std::byte *m_Mapping{};
+  std::size_t m_RegionSize{};
+  std::size_t m_Region{};
+  std::vector<GLsync> m_Fences;
+  std::size_t m_Stalls{};
+
+  void WaitForRegion(std::size_t region) noexcept;
+  void Release() noexcept;
+
+public:
+  // Regions are rounded up to a multiple of kRegionAlignment bytes so each
+  // starts suitably aligned for any vertex or uniform data
+  static constexpr std::size_t kRegionAlignment = 256;
+
+  // Throws std::invalid_argument for zero regions or a zero region size, and
+  // std::runtime_error when the driver cannot allocate or map the buffer
+  explicit StreamingBuffer(std::size_t region_size,
+    std::size_t region_count = 3);
+  StreamingBuffer(StreamingBuffer const &) = delete;
+  StreamingBuffer(StreamingBuffer &&other) noexcept;
+  auto operator=(StreamingBuffer const &) -> StreamingBuffer & = delete;
+  auto operator=(StreamingBuffer &&other) noexcept -> StreamingBuffer &;
+  ~StreamingBuffer() { Release(); }
+
+  [[nodiscard]] auto GetBufferID() const noexcept -> GLuint
+  {
+    return m_BufferID;
+  }
+  [[nodiscard]] auto GetRegionSize() const noexcept -> std::size_t
+  {
+    return m_RegionSize;
+  }
+  [[nodiscard]] auto GetRegionCount() const noexcept -> std::size_t
+  {
+    return m_Fences.size();
+  }
+  // Byte offset of the current region within the buffer
+  [[nodiscard]] auto GetRegionOffset() const noexcept -> std::size_t
+  {
+    return m_Region * m_RegionSize;
+  }
+
+  // Waits until the GPU has finished with the current region and returns it
+  // for writing
+  [[nodiscard]] auto BeginRegion() noexcept -> std::span<std::byte>;
+  template<typename T>
+    requires std::is_trivially_copyable_v<T>
+  [[nodiscard]] auto BeginRegion() noexcept -> std::span<T>
+  {
+    auto const Bytes = BeginRegion();
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    return { reinterpret_cast<T *>(Bytes.data()), Bytes.size() / sizeof(T) };
+  }
+  // Fences the current region after the commands reading it were issued and
+  // moves on to the next one
+  void EndRegion() noexcept;
+
+  // Adds the number of times BeginRegion had to wait for the GPU since the
+  // last call to statistics, then resets it
+  void CollectStatistics(FrameStatistics &statistics) noexcept;
+};
+}// namespace renderer::gl
@@ -0,0 +1,319 @@
+#pragma once
+#include <glad/glad.h>//
+//
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <renderer/colour/colour.hpp>
+#include <renderer/point/point.hpp>
+#include <renderer/utils/layoutProbe.hpp>
+#include <renderer/vector/vector.hpp>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// Vertex array formats derived at compile time from the C++ structs that are
+// uploaded into vertex buffers, so stride, offsets and component types can
+// not drift from the data they describe.
+namespace renderer::gl {
+
+// Which glVertexArrayAttrib*Format variant reads the attribute: Float feeds
+// vec inputs (converting integers, normalised or not), Integer feeds ivec and
+// uvec inputs and Double feeds dvec inputs
+enum class AttributeKind : std::uint8_t { Float, Integer, Double };
+
+struct VertexAttribute
+{
+  GLint Components{};
+  GLenum Type{};
+  bool Normalised{};
+  AttributeKind Kind{ AttributeKind::Float };
+  GLuint Offset{};
+
+  constexpr auto operator==(VertexAttribute const &) const -> bool = default;
+};
+
+// Specialise for every struct used as a vertex, listing pointers to all of
+// its members in declaration order. Member i feeds attribute location i:
+//   template<> struct renderer::gl::VertexMembers<RayVertex>
+//   {
+//     static constexpr std::tuple kList{ &RayVertex::Position,
+//       &RayVertex::Colour };
+//   };
+template<typename T> struct VertexMembers;
+
+template<typename T, std::size_t Dimension>
+struct VertexMembers<renderer::Point<T, Dimension>>
+{
+  static constexpr std::tuple kList{
+    &renderer::Point<T, Dimension>::m_PositionVector,
+    &renderer::Point<T, Dimension>::m_ColourOfPoint
+  };
+};
+
+namespace _impl {
+  template<typename T> struct MemberType;
+  template<typename Class, typename T> struct MemberType<T Class::*>
+  {
+    using Type = T;
+  };
+
+  constexpr auto AlignUp(std::size_t value, std::size_t alignment) noexcept
+    -> std::size_t
+  {
+    return (value + alignment - 1) / alignment * alignment;
+  }
+
+  template<GLenum Type, AttributeKind Kind, bool Normalised = false>
+  struct KnownComponent
+  {
+    static constexpr bool kSupported = true;
+    static constexpr GLenum kType = Type;
+    static constexpr AttributeKind kKind = Kind;
+    static constexpr bool kNormalised = Normalised;
+  };
+  template<typename T> struct ComponentType
+  {
+    static constexpr bool kSupported = false;
+  };
+  // Wrapper types such as Half describe themselves
+  template<typename T>
+    requires requires {
+      { T::kComponentType } -> std::convertible_to<GLenum>;
+      { T::kNormalised } -> std::convertible_to<bool>;
+    }
+  struct ComponentType<T>
+    : KnownComponent<T::kComponentType, AttributeKind::Float, T::kNormalised>
+  {
+  };
+  template<>
+  struct ComponentType<float> : KnownComponent<GL_FLOAT, AttributeKind::Float>
+  {
+  };
+  template<>
+  struct ComponentType<double>
+    : KnownComponent<GL_DOUBLE, AttributeKind::Double>
+  {
+  };
+  template<>
+  struct ComponentType<std::int8_t>
+    : KnownComponent<GL_BYTE, AttributeKind::Integer>
+  {
+  };
+  template<>
+  struct ComponentType<std::uint8_t>
+    : KnownComponent<GL_UNSIGNED_BYTE, AttributeKind::Integer>
+  {
+  };
+  template<>
+  struct ComponentType<std::int16_t>
+    : KnownComponent<GL_SHORT, AttributeKind::Integer>
+  {
+  };
+  template<>
+  struct ComponentType<std::uint16_t>
+    : KnownComponent<GL_UNSIGNED_SHORT, AttributeKind::Integer>
+  {
+  };
+  template<>
+  struct ComponentType<std::int32_t>
+    : KnownComponent<GL_INT, AttributeKind::Integer>
+  {
+  };
+  template<>
+  struct ComponentType<std::uint32_t>
+    : KnownComponent<GL_UNSIGNED_INT, AttributeKind::Integer>
+  {
+  };
+
+  template<typename T>
+  concept component = ComponentType<T>::kSupported;
+
+  // Format of one attribute, without its offset
+  template<typename T> struct AttributeFormat
+  {
+    static constexpr bool kSupported = false;
+  };
+  template<component T> struct AttributeFormat<T>
+  {
+    static constexpr bool kSupported = true;
+    static constexpr VertexAttribute kFormat{ 1,
+      ComponentType<T>::kType,
+      ComponentType<T>::kNormalised,
+      ComponentType<T>::kKind };
+  };
+  template<component T, std::size_t Dimension>
+    requires(Dimension >= 1 && Dimension <= 4)
+  struct AttributeFormat<renderer::Vector<T, Dimension>>
+  {
+    static constexpr bool kSupported = true;
+    static constexpr VertexAttribute kFormat{ static_cast<GLint>(Dimension),
+      ComponentType<T>::kType,
+      ComponentType<T>::kNormalised,
+      ComponentType<T>::kKind };
+  };
+  template<component T, std::size_t Dimension>
+    requires(Dimension >= 1 && Dimension <= 4)
+  struct AttributeFormat<std::array<T, Dimension>>
+    : AttributeFormat<renderer::Vector<T, Dimension>>
+  {
+  };
+  // Colours are stored as bytes and read as floats in [0, 1]
+  template<> struct AttributeFormat<renderer::RGBColour>
+  {
+    static constexpr bool kSupported = true;
+    static constexpr VertexAttribute kFormat{
+      3, GL_UNSIGNED_BYTE, true, AttributeKind::Float
+    };
+  };
+}// namespace _impl
+
+// A type that fits in a single vertex attribute
+template<typename T>
+concept attribute = _impl::AttributeFormat<T>::kSupported;
+
+template<typename T>
+concept vertex_structure = requires {
+  { VertexMembers<T>::kList };
+} && std::is_standard_layout_v<T> && std::is_trivially_copyable_v<T>;
+
+// A type that can be uploaded to a vertex buffer: a struct with
+// VertexMembers, or a single attribute such as a bare position
+template<typename T>
+concept vertex = vertex_structure<T> || attribute<T>;
+
+namespace _impl {
+  template<vertex_structure T>
+  inline constexpr std::size_t kVertexMemberCount =
+    std::tuple_size_v<std::remove_cvref_t<decltype(VertexMembers<T>::kList)>>;
+
+  template<vertex_structure T, std::size_t Index>
+  using VertexMemberAt = typename MemberType<std::tuple_element_t<Index,
+    std::remove_cvref_t<decltype(VertexMembers<T>::kList)>>>::Type;
+
+  // The C++ compiler places each member of a standard-layout struct at the
+  // next multiple of its alignment, so the offsets follow from the types
+  template<vertex_structure T> consteval auto DeriveAttributes()
+  {
+    std::array<VertexAttribute, kVertexMemberCount<T>> Attributes{};
+    std::size_t End = 0;
+    [&]<std::size_t... Index>(std::index_sequence<Index...>) {
+      static_assert((attribute<VertexMemberAt<T, Index>> && ...),
+        "Vertex member has no attribute format; use a scalar, "
+        "renderer::Vector, std::array or renderer::RGBColour");
+      ((Attributes[Index] =
+           AttributeFormat<VertexMemberAt<T, Index>>::kFormat,
+         Attributes[Index].Offset = static_cast<GLuint>(
+           AlignUp(End, alignof(VertexMemberAt<T, Index>))),
+         End = Attributes[Index].Offset + sizeof(VertexMemberAt<T, Index>)),
+        ...);
+    }(std::make_index_sequence<kVertexMemberCount<T>>{});
+    return Attributes;
+  }
+}// namespace _impl
+
+// True when VertexMembers<T> lists every member of T in declaration order,
+// so the derived offsets describe the real object. Each member is read from
+// an object whose bytes hold their own index and compared against the bytes
+// at its derived offset, which catches reordered and missing members that
+// leave the total size unchanged.
+template<vertex T> consteval auto ListsAllVertexMembers() -> bool
+{
+  if constexpr (vertex_structure<T>) {
+    std::size_t End = 0;
+    std::size_t Alignment = 1;
+    [&]<std::size_t... Index>(std::index_sequence<Index...>) {
+      ((End = _impl::AlignUp(End, alignof(_impl::VertexMemberAt<T, Index>))
+              + sizeof(_impl::VertexMemberAt<T, Index>),
+         Alignment =
+           std::max(Alignment, alignof(_impl::VertexMemberAt<T, Index>))),
+        ...);
+    }(std::make_index_sequence<_impl::kVertexMemberCount<T>>{});
+    if (_impl::AlignUp(End, Alignment) != sizeof(T)
+        || Alignment != alignof(T)) {
+      return false;
+    }
+
+    auto const Bytes = utils::MakeProbeBytes<T>();
+    auto const Probe = std::bit_cast<T>(Bytes);
+    auto const Attributes = _impl::DeriveAttributes<T>();
+    bool Matches = true;
+    [&]<std::size_t... Index>(std::index_sequence<Index...>) {
+      auto MemberMatches = [&]<std::size_t Member>() {
+        using Type = _impl::VertexMemberAt<T, Member>;
+        auto const Read = std::bit_cast<std::array<std::byte, sizeof(Type)>>(
+          Probe.*std::get<Member>(VertexMembers<T>::kList));
+        return std::ranges::equal(Read,
+          std::span(Bytes).subspan(Attributes[Member].Offset, sizeof(Type)));
+      };
+      ((Matches = Matches && MemberMatches.template operator()<Index>()),
+        ...);
+    }(std::make_index_sequence<_impl::kVertexMemberCount<T>>{});
+    return Matches;
+  } else {
+    return true;
+  }
+}
+
+template<vertex T> struct VertexLayout
+{
+  static_assert(ListsAllVertexMembers<T>(),
+    "VertexMembers must list every member of the vertex");
+  static constexpr GLsizei kStride = sizeof(T);
+  static constexpr auto kAttributes = [] {
+    if constexpr (vertex_structure<T>) {
+      return _impl::DeriveAttributes<T>();
+    } else {
+      return std::array{ _impl::AttributeFormat<T>::kFormat };
+    }
+  }();
+  static constexpr std::size_t kAttributeCount = kAttributes.size();
+};
+
+// Where a vertex buffer is attached to a vertex array
+struct VertexBufferBinding
+{
+  // Byte offset of the first vertex within the buffer
+  GLintptr Offset{};
+  GLuint BindingIndex{};
+  // Location of the first attribute, later ones follow consecutively
+  GLuint FirstLocation{};
+  // 0 advances per vertex, N advances once every N instances
+  GLuint Divisor{};
+};
+
+// Enables and formats the attributes and attaches buffer with the given
+// stride. Uses the direct state access entry points on OpenGL 4.5 and
+// binds vertex_array (leaving none bound afterwards) on older contexts.
+void SetupVertexArray(GLuint vertex_array,
+  GLuint buffer,
+  std::span<VertexAttribute const> attributes,
+  GLsizei stride,
+  VertexBufferBinding const &binding = {}) noexcept;
+
+// One call setup for buffers holding an array of T. With direct state
+// access, vertex_array has to come from glCreateVertexArrays.
+template<vertex T>
+void SetupVertexArray(GLuint vertex_array,
+  GLuint buffer,
+  VertexBufferBinding const &binding = {}) noexcept
+{
+  SetupVertexArray(vertex_array,
+    buffer,
+    VertexLayout<T>::kAttributes,
+    VertexLayout<T>::kStride,
+    binding);
+}
+
+// Copies bytes into buffer, replacing it with a larger one when it is too
+// small, since immutable storage cannot grow. capacity tracks the size of
+// buffer; a zero capacity creates the first one. Pre 4.5 contexts get a
+// buffer with mutable storage, which is resized in place.
+void UploadGrowing(GLuint &buffer,
+  std::size_t &capacity,
+  std::span<std::byte const> bytes);
+}// namespace renderer::gl
@@ -32,6 +32,10 @@ public:
   constexpr explicit RedNormalised(Red red)
     : m_Value(static_cast<float>(red.Value) / red.kMaxSize)
   {}
+  [[nodiscard]] constexpr auto Value() const noexcept -> float
+  {
+    return m_Value;
+  }
 };
 class [[nodiscard]] GreenNormalised
 {
@@ -42,6 +46,10 @@ public:
   constexpr explicit GreenNormalised(Green green)
     : m_Value(static_cast<float>(green.Value) / green.kMaxSize)
   {}
+  [[nodiscard]] constexpr auto Value() const noexcept -> float
+  {
+    return m_Value;
+  }
 };
 struct [[nodiscard]] BlueNormalised
 {
@@ -52,6 +60,10 @@ public:
   constexpr explicit BlueNormalised(Blue blue)
     : m_Value(static_cast<float>(blue.Value) / blue.kMaxSize)
   {}
+  [[nodiscard]] constexpr auto Value() const noexcept -> float
+  {
+    return m_Value;
+  }
 };
 class [[nodiscard]] RGBColour
 {
@@ -83,6 +95,10 @@ class [[nodiscard]] RBGColourNormalised
   BlueNormalised m_Blue;
 
 public:
+  RBGColourNormalised() = default;
+  constexpr explicit RBGColourNormalised(RGBColour const &colour)
+    : m_Red(colour.Red()), m_Green(colour.Green()), m_Blue(colour.Blue())
+  {}
   constexpr auto Red() noexcept -> RedNormalised & { return m_Red; }
   constexpr auto Blue() noexcept -> BlueNormalised & { return m_Blue; }
   constexpr auto Green() noexcept -> GreenNormalised & { return m_Green; }
@@ -0,0 +1,59 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <renderer/colour/colour.hpp>
+#include <renderer/vector/vector.hpp>
+#include <span>
+
+// Whole-image conversions between 8 bit storage and float compute formats.
+// Every batch function gives exactly the result of its scalar counterpart
+// on each element, whether or not it takes the SIMD path. destination must
+// be at least as long as source.
+namespace renderer {
+
+// Inverse of the normalising constructors: clamps to [0, 1], scales to 255
+// and rounds half up. NaN becomes 0.
+constexpr auto QuantiseChannel(float value) noexcept -> std::uint8_t
+{
+  if (!(value > 0.0F)) { return 0; }
+  if (value >= 1.0F) { return static_cast<std::uint8_t>(Red::kMaxSize); }
+  // Two statements, so the multiply and add are never fused into an FMA
+  float const Scaled = value * static_cast<float>(Red::kMaxSize);
+  return static_cast<std::uint8_t>(Scaled + 0.5F);
+}
+
+// The sRGB transfer function and its inverse, on values in [0, 1]
+auto SrgbToLinear(float encoded) noexcept -> float;
+auto LinearToSrgb(float linear) noexcept -> float;
+// 8 bit sRGB codes from and to linear intensity. DecodeSrgb is a table
+// lookup. EncodeSrgb gives the code nearest 255 * LinearToSrgb(linear) by
+// comparing against the linear values halfway between codes; NaN gives 0.
+auto DecodeSrgb(std::uint8_t encoded) noexcept -> float;
+auto EncodeSrgb(float linear) noexcept -> std::uint8_t;
+
+// Bytes to [0, 1] and back, matching RedNormalised(Red) and
+// QuantiseChannel
+void NormaliseChannels(std::span<std::uint8_t const> source,
+  std::span<float> destination) noexcept;
+void QuantiseChannels(std::span<float const> source,
+  std::span<std::uint8_t> destination) noexcept;
+void NormaliseChannels(std::span<RGBColour const> source,
+  std::span<RBGColourNormalised> destination) noexcept;
+void QuantiseChannels(std::span<RBGColourNormalised const> source,
+  std::span<RGBColour> destination) noexcept;
+
+// Packed RGBA8 pixels, red in the lowest byte as GL_RGBA / GL_UNSIGNED_BYTE
+// reads them on little endian machines, to and from normalised float4
+void UnpackRGBA8(std::span<std::uint32_t const> source,
+  std::span<Vector4<float>> destination) noexcept;
+void PackRGBA8(std::span<Vector4<float> const> source,
+  std::span<std::uint32_t> destination) noexcept;
+
+// 8 bit sRGB channels to linear floats and back. These are table driven
+// on every path: without a gather instruction a SIMD version loads the
+// same table entries one at a time anyway.
+void DecodeSrgb(std::span<std::uint8_t const> source,
+  std::span<float> destination) noexcept;
+void EncodeSrgb(std::span<float const> source,
+  std::span<std::uint8_t> destination) noexcept;
+}// namespace renderer
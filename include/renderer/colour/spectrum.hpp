@@ -0,0 +1,209 @@
+#pragma once
+#include <glad/glad.h>//
+//
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <renderer/colour/colour.hpp>
+#include <renderer/colour/colourConversion.hpp>
+#include <renderer/object/glObject.hpp>
+#include <renderer/utils/constexprMath.hpp>
+#include <renderer/vector/vector.hpp>
+#include <span>
+
+// Colours of monochromatic light for dispersion and rainbow rendering,
+// tabulated at compile time so a ray's colour costs one interpolated
+// lookup instead of evaluating the colour matching functions.
+namespace renderer {
+
+namespace _impl {
+  // Piecewise Gaussian with separate widths below and above its peak
+  constexpr auto SplitGaussian(double wavelength,
+    double mean,
+    double width_below,
+    double width_above) noexcept -> double
+  {
+    auto const Width = wavelength < mean ? width_below : width_above;
+    auto const T = (wavelength - mean) / Width;
+    if consteval {
+      return math::Exp(-0.5 * T * T);
+    } else {
+      return std::exp(-0.5 * T * T);
+    }
+  }
+}// namespace _impl
+
+// CIE 1931 2 degree colour matching functions (x, y, z) at wavelength in
+// nanometres, from the multi-lobe fit of Wyman, Sloan and Shirley, "Simple
+// Analytic Approximations to the CIE XYZ Color Matching Functions" (2013)
+constexpr auto CieColourMatching(double wavelength) noexcept -> Vector3<double>
+{
+  using _impl::SplitGaussian;
+  // NOLINTBEGIN(readability-magic-numbers)
+  return { { 1.056 * SplitGaussian(wavelength, 599.8, 37.9, 31.0)
+               + 0.362 * SplitGaussian(wavelength, 442.0, 16.0, 26.7)
+               - 0.065 * SplitGaussian(wavelength, 501.1, 20.4, 26.2),
+    0.821 * SplitGaussian(wavelength, 568.8, 46.9, 40.5)
+      + 0.286 * SplitGaussian(wavelength, 530.9, 16.3, 31.1),
+    1.217 * SplitGaussian(wavelength, 437.0, 11.8, 36.0)
+      + 0.681 * SplitGaussian(wavelength, 459.0, 26.0, 13.8) } };
+  // NOLINTEND(readability-magic-numbers)
+}
+
+// CIE XYZ to linear sRGB primaries with a D65 white point
+constexpr auto XyzToLinearSrgb(Vector3<double> const &xyz) noexcept
+  -> Vector3<double>
+{
+  auto const [X, Y, Z] = xyz.m_Values;
+  // NOLINTBEGIN(readability-magic-numbers)
+  return { { 3.2404542 * X - 1.5371385 * Y - 0.4985314 * Z,
+    -0.9692660 * X + 1.8760108 * Y + 0.0415560 * Z,
+    0.0556434 * X - 0.2040259 * Y + 1.0572252 * Z } };
+  // NOLINTEND(readability-magic-numbers)
+}
+
+// Samples evenly spaced from kMinWavelength to kMaxWavelength inclusive,
+// so the default resolution has one sample per nanometre. Build one with
+// MakeSpectrumTable, or use kSpectrumTable.
+template<std::size_t Samples>
+  requires(Samples >= 2)
+class SpectrumTable
+{
+public:
+  static constexpr float kMinWavelength = 380.0F;
+  static constexpr float kMaxWavelength = 780.0F;
+  static constexpr std::size_t kSamples = Samples;
+
+  // Linear sRGB in [0, 1], for lighting and for the texture
+  std::array<Vector3<float>, Samples> m_Linear{};
+  // The same colours encoded with the sRGB curve, for RGBColour output
+  std::array<Vector3<float>, Samples> m_Encoded{};
+
+  // Linear sRGB at wavelength, interpolated between the two nearest
+  // samples; outside the table the end samples are used
+  [[nodiscard]] constexpr auto SampleLinear(float wavelength) const noexcept
+    -> Vector3<float>
+  {
+    return Interpolate(m_Linear, wavelength);
+  }
+  [[nodiscard]] constexpr auto SampleColour(float wavelength) const noexcept
+    -> RGBColour
+  {
+    auto const [R, G, B] = Interpolate(m_Encoded, wavelength).m_Values;
+    RGBColour Colour;
+    Colour.Red().Value = QuantiseChannel(R);
+    Colour.Green().Value = QuantiseChannel(G);
+    Colour.Blue().Value = QuantiseChannel(B);
+    return Colour;
+  }
+  void SampleLinear(std::span<float const> wavelengths,
+    std::span<Vector3<float>> destination) const noexcept
+  {
+    assert(destination.size() >= wavelengths.size());
+    for (std::size_t Index = 0; Index < wavelengths.size(); ++Index) {
+      destination[Index] = SampleLinear(wavelengths[Index]);
+    }
+  }
+  void SampleColours(std::span<float const> wavelengths,
+    std::span<RGBColour> destination) const noexcept
+  {
+    assert(destination.size() >= wavelengths.size());
+    for (std::size_t Index = 0; Index < wavelengths.size(); ++Index) {
+      destination[Index] = SampleColour(wavelengths[Index]);
+    }
+  }
+
+  // Fills texture, which must not have storage yet, with the linear table
+  // as a GL_RGB32F 1D texture with linear filtering. A shader reproduces
+  // SampleLinear by sampling texel centres:
+  //   float u = (wavelength - 380.0) / 400.0;
+  //   texture(uSpectrum, (u * (kSamples - 1) + 0.5) / kSamples).rgb
+  void Upload(gl::Texture const &texture) const noexcept
+  {
+    texture.Storage1D(1, GL_RGB32F, static_cast<GLsizei>(Samples));
+    texture.SubImage1D(0,
+      0,
+      static_cast<GLsizei>(Samples),
+      GL_RGB,
+      GL_FLOAT,
+      m_Linear.data());
+    texture.SetParameter(GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    texture.SetParameter(GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    texture.SetParameter(GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+  }
+
+private:
+  static constexpr auto Interpolate(
+    std::array<Vector3<float>, Samples> const &table,
+    float wavelength) noexcept -> Vector3<float>
+  {
+    constexpr auto kLast = static_cast<float>(Samples - 1);
+    auto Position = (wavelength - kMinWavelength)
+                    / (kMaxWavelength - kMinWavelength) * kLast;
+    // Also sends NaN to the first sample
+    if (!(Position > 0.0F)) { Position = 0.0F; }
+    Position = std::min(Position, kLast);
+    auto const Below =
+      std::min(static_cast<std::size_t>(Position), Samples - 2);
+    auto const Fraction = Position - static_cast<float>(Below);
+    Vector3<float> Result{};
+    for (std::size_t Channel = 0; Channel < 3; ++Channel) {
+      auto const Low = table[Below].m_Values[Channel];
+      auto const High = table[Below + 1].m_Values[Channel];
+      Result.m_Values[Channel] = Low + (High - Low) * Fraction;
+    }
+    return Result;
+  }
+};
+
+// Colours outside the sRGB gamut, which is every spectral colour, are
+// desaturated towards white until no channel is negative. The table is
+// then scaled so its brightest channel is 1, keeping the relative
+// brightness across the spectrum: both ends fade to black.
+template<std::size_t Samples = 401>
+consteval auto MakeSpectrumTable() -> SpectrumTable<Samples>
+{
+  using Table = SpectrumTable<Samples>;
+  std::array<Vector3<double>, Samples> Linear{};
+  double Brightest = 0.0;
+  for (std::size_t Index = 0; Index < Samples; ++Index) {
+    auto const Wavelength =
+      Table::kMinWavelength
+      + (static_cast<double>(Table::kMaxWavelength) - Table::kMinWavelength)
+          * static_cast<double>(Index) / static_cast<double>(Samples - 1);
+    auto Colour = XyzToLinearSrgb(CieColourMatching(Wavelength));
+    auto const Lowest = std::min({ Colour.m_Values[0],
+      Colour.m_Values[1],
+      Colour.m_Values[2] });
+    for (auto &Channel : Colour.m_Values) {
+      if (Lowest < 0.0) { Channel -= Lowest; }
+      Brightest = std::max(Brightest, Channel);
+    }
+    Linear[Index] = Colour;
+  }
+
+  constexpr double kLinearEnd = 0.0031308;
+  constexpr double kSlope = 12.92;
+  constexpr double kScale = 1.055;
+  constexpr double kOffset = 0.055;
+  constexpr double kGamma = 2.4;
+  Table Result;
+  for (std::size_t Index = 0; Index < Samples; ++Index) {
+    for (std::size_t Channel = 0; Channel < 3; ++Channel) {
+      auto const Value = Linear[Index].m_Values[Channel] / Brightest;
+      auto const Encoded =
+        Value <= kLinearEnd
+          ? Value * kSlope
+          : kScale * math::Pow(Value, 1.0 / kGamma) - kOffset;
+      Result.m_Linear[Index].m_Values[Channel] = static_cast<float>(Value);
+      Result.m_Encoded[Index].m_Values[Channel] = static_cast<float>(Encoded);
+    }
+  }
+  return Result;
+}
+
+// One sample per nanometre over the visible range
+inline constexpr auto kSpectrumTable = MakeSpectrumTable();
+}// namespace renderer
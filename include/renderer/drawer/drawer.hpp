@@ -6,48 +6,50 @@
 #include <concepts>
 #include <cstddef>
 #include <functional>
-#include <initializer_list>
 #include <iterator>
 #include <ranges>
 #include <renderer/utils/concepts.hpp>
+#include <renderer/utils/inlineFunction.hpp>
 #include <tuple>
 #include <type_traits>
+#include <utility>
 
 
 namespace renderer::drawer {
 
-template<typename T> class Drawer;
+inline constexpr std::size_t kDefaultDrawerCapacity =
+  utils::kDefaultInlineFunctionCapacity;
 
-template<typename Ret, typename... Params>
-class [[nodiscard]] Drawer<Ret(Params...)>
+template<typename T, std::size_t Capacity = kDefaultDrawerCapacity>
+class Drawer;
+
+// Draw strategies are stored inline (see utils::InlineFunction), so a Drawer
+// never allocates and is move-only. Capacity bounds the size of the strategy.
+template<typename Ret, typename... Params, std::size_t Capacity>
+class [[nodiscard]] Drawer<Ret(Params...), Capacity>
 {
   using Signature = Ret(Params...);
-  std::function<Signature> m_DrawStrategy{};
+  utils::InlineFunction<Signature, Capacity> m_DrawStrategy{};
 
 public:
   using RetType = Ret;
   using ParamType = std::tuple<Params...>;
+  static constexpr std::size_t kCapacity = Capacity;
   template<typename Func>
-  constexpr explicit Drawer(Func draw_strategy)
-    requires(std::is_invocable_r_v<RetType, Func, Params...>)
-    : m_DrawStrategy(draw_strategy)
+  explicit Drawer(Func draw_strategy)
+    requires(std::is_invocable_r_v<RetType, Func &, Params...>)
+    : m_DrawStrategy(std::move(draw_strategy))
   {}
   Drawer() = default;
-  constexpr Drawer(Drawer const &other) = default;
-  constexpr Drawer(Drawer &&) = default;
-  constexpr auto operator=(Drawer const &other) -> Drawer & = default;
-  constexpr auto operator=(Drawer &&) -> Drawer & = default;
-  constexpr ~Drawer() = default;
+  Drawer(Drawer const &other) = delete;
+  Drawer(Drawer &&) noexcept = default;
+  auto operator=(Drawer const &other) -> Drawer & = delete;
+  auto operator=(Drawer &&) noexcept -> Drawer & = default;
+  ~Drawer() = default;
   // Draw
   auto Draw(Params... args) -> RetType
-    requires(!std::same_as<RetType, void>)
-  {
-    return m_DrawStrategy(args...);
-  }
-  auto Draw(Params... args) -> RetType
-    requires(std::same_as<RetType, void>)
   {
-    m_DrawStrategy(args...);
+    return m_DrawStrategy(std::forward<Params>(args)...);
   }
 };
 template<concepts::signature Signature,
@@ -115,10 +117,11 @@ public:
   {
     return std::crend(m_Drawers);
   }
-  StaticDrawerSet(std::initializer_list<Drawer<Signature>> list_of_drawers)
-  {
-    std::ranges::copy(list_of_drawers, std::begin(m_Drawers));
-  }
+  template<typename... Drawers>
+    requires(sizeof...(Drawers) == Number
+             && (std::same_as<Drawers, Drawer<Signature>> && ...))
+  StaticDrawerSet(Drawers &&...drawers) : m_Drawers{ std::move(drawers)... }
+  {}
   constexpr auto operator<=>(StaticDrawerSet const &other) const
     -> bool = default;
   constexpr auto Draw(ParamType... params) -> std::array<RetType, Number>
@@ -143,4 +146,75 @@ public:
     std::ranges::for_each(m_Drawers, [](auto &value) { value.Draw(); });
   }
 };
+
+namespace _impl {
+  // Pipeline elements are either drawers (anything with a matching Draw) or
+  // plain callables such as lambdas.
+  template<typename Func, typename Ret, typename... Params>
+  concept pipeline_element =
+    requires(Func &func, Params &...params) {
+      { func.Draw(params...) } -> std::convertible_to<Ret>;
+    } || std::is_invocable_r_v<Ret, Func &, Params &...>;
+
+  template<typename Func, typename... Params>
+  constexpr auto DrawElement(Func &func, Params &...params) -> decltype(auto)
+  {
+    if constexpr (requires { func.Draw(params...); }) {
+      return func.Draw(params...);
+    } else {
+      return std::invoke(func, params...);
+    }
+  }
+}// namespace _impl
+
+// Compile-time sibling of StaticDrawerSet: every element keeps its concrete
+// type, so Draw expands to a sequence of direct calls the compiler can inline.
+// Elements are drawn in the order they were given, as with StaticDrawerSet.
+template<concepts::signature Signature, typename... Funcs>
+class [[nodiscard]] StaticDrawerPipeline;
+
+template<typename RetType, typename... ParamType, typename... Funcs>
+  requires(_impl::pipeline_element<Funcs, RetType, ParamType...> && ...)
+class [[nodiscard]] StaticDrawerPipeline<RetType(ParamType...), Funcs...>
+{
+  std::tuple<Funcs...> m_Drawers;
+
+public:
+  static constexpr std::size_t kNumber = sizeof...(Funcs);
+  constexpr explicit StaticDrawerPipeline(Funcs... drawers)
+    : m_Drawers(std::move(drawers)...)
+  {}
+  template<std::size_t Index>
+  [[nodiscard]] constexpr auto Get() noexcept -> auto &
+  {
+    return std::get<Index>(m_Drawers);
+  }
+  constexpr auto Draw(ParamType... params) -> std::array<RetType, kNumber>
+    requires(!std::same_as<RetType, void>)
+  {
+    return std::apply(
+      [&params...](auto &...drawers) {
+        // Braced initialisation evaluates its elements left to right
+        return std::array<RetType, kNumber>{ static_cast<RetType>(
+          _impl::DrawElement(drawers, params...))... };
+      },
+      m_Drawers);
+  }
+  constexpr void Draw(ParamType... params)
+    requires(std::same_as<RetType, void>)
+  {
+    std::apply(
+      [&params...](
+        auto &...drawers) { (_impl::DrawElement(drawers, params...), ...); },
+      m_Drawers);
+  }
+};
+
+template<concepts::signature Signature, typename... Funcs>
+constexpr auto MakeStaticDrawerPipeline(Funcs &&...drawers)
+  -> StaticDrawerPipeline<Signature, std::decay_t<Funcs>...>
+{
+  return StaticDrawerPipeline<Signature, std::decay_t<Funcs>...>(
+    std::forward<Funcs>(drawers)...);
+}
 }// namespace renderer::drawer
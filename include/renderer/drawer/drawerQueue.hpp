@@ -0,0 +1,165 @@
+#pragma once
+#include <glad/glad.h>//
+//
+#include <algorithm>
+#include <array>
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <renderer/drawer/drawer.hpp>
+#include <renderer/utils/concepts.hpp>
+#include <renderer/utils/frameStatistics.hpp>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace renderer::drawer {
+
+enum class BlendMode : std::uint8_t { Opaque, Alpha, Additive };
+
+inline constexpr std::size_t kSortedTextureUnits = 4;
+
+// Sort key of a queued drawer. Members are compared in declaration order, so
+// opaque work is drawn before blended work and, within a blend mode, drawers
+// sharing a program and vertex array end up next to each other. Texture 0
+// marks a unit the drawer does not use; the queue leaves such units alone.
+struct DrawState
+{
+  BlendMode Blend{ BlendMode::Opaque };
+  GLuint Program{};
+  GLuint VertexArray{};
+  std::array<GLuint, kSortedTextureUnits> Textures{};
+
+  constexpr auto operator<=>(DrawState const &) const = default;
+};
+
+// Issues the actual GL calls for StateSortedDrawerQueue
+struct GLStateBinder
+{
+  static void BindProgram(GLuint program) noexcept;
+  static void BindVertexArray(GLuint vertex_array) noexcept;
+  static void BindTexture(GLuint unit, GLuint texture) noexcept;
+  static void SetBlendMode(BlendMode mode) noexcept;
+};
+
+template<typename Binder>
+concept state_binder = requires(Binder &binder, GLuint name, BlendMode mode) {
+  binder.BindProgram(name);
+  binder.BindVertexArray(name);
+  binder.BindTexture(name, name);
+  binder.SetBlendMode(mode);
+};
+
+// Runtime drawer queue: each submission carries the GL state it needs. Draw
+// sorts submissions by that state (keeping submission order for equal keys)
+// and binds only what differs from the previous submission, so drawers
+// should not bind their program, vertex array or textures themselves.
+template<concepts::signature Signature,
+  state_binder Binder = GLStateBinder,
+  std::size_t Capacity = kDefaultDrawerCapacity>
+class [[nodiscard]] StateSortedDrawerQueue;
+
+template<typename... Params, state_binder Binder, std::size_t Capacity>
+class [[nodiscard]] StateSortedDrawerQueue<void(Params...), Binder, Capacity>
+{
+  using DrawerType = Drawer<void(Params...), Capacity>;
+  struct Submission
+  {
+    DrawState State;
+    DrawerType Drawer;
+  };
+  std::vector<Submission> m_Submissions{};
+  bool m_Sorted{ true };
+  Binder m_Binder{};
+  FrameStatistics m_Statistics{};
+
+  // bound holds the texture the queue last bound to each unit during this
+  // Draw, or 0 while the unit has not been touched
+  void Bind(DrawState const &state,
+    DrawState const *previous,
+    std::array<GLuint, kSortedTextureUnits> &bound)
+  {
+    auto Changed = [&](auto member) {
+      if (previous != nullptr && previous->*member == state.*member) {
+        ++m_Statistics.RedundantBindsSkipped;
+        return false;
+      }
+      return true;
+    };
+    if (Changed(&DrawState::Blend)) {
+      m_Binder.SetBlendMode(state.Blend);
+      ++m_Statistics.BlendChanges;
+    }
+    if (Changed(&DrawState::Program)) {
+      m_Binder.BindProgram(state.Program);
+      ++m_Statistics.ProgramBinds;
+    }
+    if (Changed(&DrawState::VertexArray)) {
+      m_Binder.BindVertexArray(state.VertexArray);
+      ++m_Statistics.VertexArrayBinds;
+    }
+    for (std::size_t Unit = 0; Unit < kSortedTextureUnits; ++Unit) {
+      auto const Texture = state.Textures[Unit];
+      if (Texture == 0) { continue; }
+      if (bound[Unit] == Texture) {
+        ++m_Statistics.RedundantBindsSkipped;
+        continue;
+      }
+      m_Binder.BindTexture(static_cast<GLuint>(Unit), Texture);
+      bound[Unit] = Texture;
+      ++m_Statistics.TextureBinds;
+    }
+  }
+
+public:
+  StateSortedDrawerQueue() = default;
+  explicit StateSortedDrawerQueue(Binder binder) : m_Binder(std::move(binder))
+  {}
+
+  void Reserve(std::size_t count) { m_Submissions.reserve(count); }
+  void Submit(DrawState const &state, DrawerType drawer)
+  {
+    m_Submissions.push_back(Submission{ state, std::move(drawer) });
+    m_Sorted = false;
+  }
+  template<typename Func>
+    requires(std::is_invocable_r_v<void, Func &, Params...>)
+  void Submit(DrawState const &state, Func draw_strategy)
+  {
+    Submit(state, DrawerType(std::move(draw_strategy)));
+  }
+  void Clear() noexcept
+  {
+    m_Submissions.clear();
+    m_Sorted = true;
+  }
+  [[nodiscard]] auto Size() const noexcept -> std::size_t
+  {
+    return m_Submissions.size();
+  }
+  [[nodiscard]] auto GetBinder() noexcept -> Binder & { return m_Binder; }
+  // Counters for the most recent Draw
+  [[nodiscard]] auto GetStatistics() const noexcept -> FrameStatistics const &
+  {
+    return m_Statistics;
+  }
+
+  void Draw(Params... params)
+  {
+    if (!m_Sorted) {
+      std::ranges::stable_sort(m_Submissions, {}, &Submission::State);
+      m_Sorted = true;
+    }
+    m_Statistics = {};
+    DrawState const *Previous = nullptr;
+    std::array<GLuint, kSortedTextureUnits> BoundTextures{};
+    for (auto &[State, Drawer] : m_Submissions) {
+      Bind(State, Previous, BoundTextures);
+      Drawer.Draw(params...);
+      ++m_Statistics.DrawerCalls;
+      Previous = &State;
+    }
+  }
+};
+}// namespace renderer::drawer
@@ -1,10 +1,28 @@
 #pragma once
+#include <glad/glad.h>//
+//
 #include <GLFW/glfw3.h>
 #include <chrono>
 #include <renderer/drawer/drawer.hpp>
+#include <renderer/drawer/drawerQueue.hpp>
+#include <type_traits>
+#include <utility>
 
 namespace renderer {
-using OpenGLDrawer =
-  renderer::drawer::Drawer<void(GLFWwindow const &, std::chrono::nanoseconds)>;
+using OpenGLDrawerSignature = void(GLFWwindow const &,
+  std::chrono::nanoseconds);
+using OpenGLDrawer = renderer::drawer::Drawer<OpenGLDrawerSignature>;
+using OpenGLDrawerQueue =
+  renderer::drawer::StateSortedDrawerQueue<OpenGLDrawerSignature>;
+template<typename... Funcs>
+using OpenGLDrawerPipeline =
+  renderer::drawer::StaticDrawerPipeline<OpenGLDrawerSignature, Funcs...>;
 
+template<typename... Funcs>
+auto MakeOpenGLDrawerPipeline(Funcs &&...drawers)
+  -> OpenGLDrawerPipeline<std::decay_t<Funcs>...>
+{
+  return renderer::drawer::MakeStaticDrawerPipeline<OpenGLDrawerSignature>(
+    std::forward<Funcs>(drawers)...);
 }
+}// namespace renderer
@@ -8,18 +8,21 @@
 namespace renderer {
 class CompilationError : std::exception
 {
-  char const *m_ErrMsg;
+  std::string m_ErrMsg;
 
 public:
-  constexpr explicit CompilationError(char const *what) noexcept
+  constexpr explicit CompilationError(char const *what)
     : m_ErrMsg(what)
   {}
-  constexpr explicit CompilationError(std::string_view what) noexcept
-    : m_ErrMsg(what.data())
+  constexpr explicit CompilationError(std::string_view what)
+    : m_ErrMsg(what)
+  {}
+  constexpr explicit CompilationError(std::string what)
+    : m_ErrMsg(std::move(what))
   {}
   [[nodiscard]] constexpr auto what() const noexcept -> char const * override
   {
-    return m_ErrMsg;
+    return m_ErrMsg.data();
   }
 };
 class UniformError : std::exception
@@ -27,8 +30,8 @@ class UniformError : std::exception
   std::string m_What;
 
 public:
-  constexpr explicit UniformError(char const *what) noexcept : m_What(what) {}
-  constexpr explicit UniformError(std::string what) noexcept
+  constexpr explicit UniformError(char const *what) : m_What(what) {}
+  constexpr explicit UniformError(std::string what)
     : m_What(std::move(what))
   {}
   [[nodiscard]] constexpr auto what() const noexcept -> char const * override
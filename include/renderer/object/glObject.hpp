@@ -0,0 +1,193 @@
+#pragma once
+#include <glad/glad.h>//
+//
+#include <cstddef>
+#include <cstdint>
+#include <renderer/buffer/vertexLayout.hpp>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace renderer::gl {
+
+enum class ObjectType : std::uint8_t {
+  Buffer,
+  VertexArray,
+  Texture,
+  Framebuffer
+};
+
+// Source of GL object names for one object type. Names are created
+// batch_size at a time with a single glCreate* call, and released names are
+// deleted together once batch_size of them have been returned. Textures are
+// created for a single target, so each texture target needs its own pool.
+//
+// Every handle drawing from a pool must be destroyed before the pool.
+class ObjectPool
+{
+  ObjectType m_Type;
+  GLenum m_TextureTarget;
+  std::size_t m_BatchSize;
+  std::vector<GLuint> m_Created;
+  std::vector<GLuint> m_Released;
+
+  void Delete(std::span<GLuint const> names) const noexcept;
+
+public:
+  static constexpr std::size_t kDefaultBatchSize = 16;
+
+  explicit ObjectPool(ObjectType type,
+    std::size_t batch_size = kDefaultBatchSize);
+  ObjectPool(GLenum texture_target, std::size_t batch_size);
+  ObjectPool(ObjectPool const &) = delete;
+  ObjectPool(ObjectPool &&) = delete;
+  auto operator=(ObjectPool const &) -> ObjectPool & = delete;
+  auto operator=(ObjectPool &&) -> ObjectPool & = delete;
+  ~ObjectPool();
+
+  [[nodiscard]] auto GetType() const noexcept -> ObjectType { return m_Type; }
+  [[nodiscard]] auto GetTextureTarget() const noexcept -> GLenum
+  {
+    return m_TextureTarget;
+  }
+  // A freshly created object; creates the next batch when none is left
+  [[nodiscard]] auto Acquire() -> GLuint;
+  void Release(GLuint name);
+  // Deletes the released names now instead of once a batch has gathered
+  void Flush() noexcept;
+  // Names created but not yet handed out
+  [[nodiscard]] auto GetAvailable() const noexcept -> std::size_t
+  {
+    return m_Created.size();
+  }
+};
+
+// Move-only owner of one GL object name taken from an ObjectPool. An empty
+// handle (name 0) owns nothing.
+template<ObjectType Type> class ObjectHandle
+{
+  GLuint m_Name{};
+  ObjectPool *m_Pool{};
+
+protected:
+  ObjectHandle() = default;
+  explicit ObjectHandle(ObjectPool &pool)
+    : m_Name(pool.Acquire()), m_Pool(&pool)
+  {}
+
+public:
+  static constexpr ObjectType kType = Type;
+
+  ObjectHandle(ObjectHandle const &) = delete;
+  ObjectHandle(ObjectHandle &&other) noexcept
+    : m_Name(std::exchange(other.m_Name, 0)),
+      m_Pool(std::exchange(other.m_Pool, nullptr))
+  {}
+  auto operator=(ObjectHandle const &) -> ObjectHandle & = delete;
+  auto operator=(ObjectHandle &&other) noexcept -> ObjectHandle &
+  {
+    if (this != &other) {
+      Reset();
+      m_Name = std::exchange(other.m_Name, 0);
+      m_Pool = std::exchange(other.m_Pool, nullptr);
+    }
+    return *this;
+  }
+  ~ObjectHandle() { Reset(); }
+
+  void Reset() noexcept
+  {
+    if (m_Pool != nullptr) { m_Pool->Release(std::exchange(m_Name, 0)); }
+    m_Pool = nullptr;
+  }
+  [[nodiscard]] auto GetName() const noexcept -> GLuint { return m_Name; }
+  [[nodiscard]] explicit operator bool() const noexcept { return m_Name != 0; }
+};
+
+class Buffer : public ObjectHandle<ObjectType::Buffer>
+{
+public:
+  Buffer() = default;
+  explicit Buffer(ObjectPool &pool) : ObjectHandle(pool) {}
+
+  // Allocates immutable storage, optionally filled with data
+  void Storage(GLsizeiptr size, GLbitfield flags) const noexcept;
+  void Storage(std::span<std::byte const> data,
+    GLbitfield flags) const noexcept;
+  // Needs GL_DYNAMIC_STORAGE_BIT storage
+  void SubData(GLintptr offset,
+    std::span<std::byte const> data) const noexcept;
+  [[nodiscard]] auto GetSize() const noexcept -> GLsizeiptr;
+};
+
+class VertexArray : public ObjectHandle<ObjectType::VertexArray>
+{
+public:
+  VertexArray() = default;
+  explicit VertexArray(ObjectPool &pool) : ObjectHandle(pool) {}
+
+  void SetVertexBuffer(GLuint binding_index,
+    Buffer const &buffer,
+    GLintptr offset,
+    GLsizei stride) const noexcept;
+  void SetElementBuffer(Buffer const &buffer) const noexcept;
+  // Formats and attaches buffer as an array of T, see SetupVertexArray
+  template<vertex T>
+  void SetLayout(GLuint buffer,
+    VertexBufferBinding const &binding = {}) const noexcept
+  {
+    SetupVertexArray<T>(GetName(), buffer, binding);
+  }
+  template<vertex T>
+  void SetLayout(Buffer const &buffer,
+    VertexBufferBinding const &binding = {}) const noexcept
+  {
+    SetLayout<T>(buffer.GetName(), binding);
+  }
+  void Bind() const noexcept;
+};
+
+class Texture : public ObjectHandle<ObjectType::Texture>
+{
+public:
+  Texture() = default;
+  explicit Texture(ObjectPool &pool) : ObjectHandle(pool) {}
+
+  void Storage1D(GLsizei levels,
+    GLenum internal_format,
+    GLsizei width) const noexcept;
+  void Storage2D(GLsizei levels,
+    GLenum internal_format,
+    GLsizei width,
+    GLsizei height) const noexcept;
+  void SubImage1D(GLint level,
+    GLint x,
+    GLsizei width,
+    GLenum format,
+    GLenum type,
+    void const *pixels) const noexcept;
+  void SubImage2D(GLint level,
+    GLint x,
+    GLint y,
+    GLsizei width,
+    GLsizei height,
+    GLenum format,
+    GLenum type,
+    void const *pixels) const noexcept;
+  void SetParameter(GLenum parameter, GLint value) const noexcept;
+  void Bind(GLuint unit) const noexcept;
+};
+
+class Framebuffer : public ObjectHandle<ObjectType::Framebuffer>
+{
+public:
+  Framebuffer() = default;
+  explicit Framebuffer(ObjectPool &pool) : ObjectHandle(pool) {}
+
+  void AttachTexture(GLenum attachment,
+    Texture const &texture,
+    GLint level = 0) const noexcept;
+  [[nodiscard]] auto IsComplete() const noexcept -> bool;
+  void Bind(GLenum target = GL_FRAMEBUFFER) const noexcept;
+};
+}// namespace renderer::gl
@@ -0,0 +1,169 @@
+#pragma once
+#include <glad/glad.h>//
+//
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <ranges>
+#include <renderer/buffer/vertexLayout.hpp>
+#include <renderer/drawer/openGlDrawer.hpp>
+#include <renderer/shader/shader.hpp>
+#include <span>
+#include <vector>
+
+namespace renderer::gl {
+
+// Layout glMultiDrawArraysIndirect reads from GL_DRAW_INDIRECT_BUFFER
+struct DrawArraysIndirectCommand
+{
+  GLuint Count{};
+  GLuint InstanceCount{};
+  GLuint First{};
+  GLuint BaseInstance{};
+
+  constexpr auto operator==(DrawArraysIndirectCommand const &) const
+    -> bool = default;
+};
+static_assert(sizeof(DrawArraysIndirectCommand) == 4 * sizeof(GLuint));
+
+// Ends a line strip in the primitive restart fallback
+inline constexpr GLuint kPrimitiveRestartIndex =
+  std::numeric_limits<GLuint>::max();
+
+// Packs polylines of varying length, such as rays traced through a lens
+// system, back to back into one vertex array, with one indirect draw
+// command per polyline. Polylines of fewer than two vertices draw nothing
+// and are dropped.
+template<vertex Vertex> class PolylineBatch
+{
+  std::vector<Vertex> m_Vertices;
+  std::vector<DrawArraysIndirectCommand> m_Commands;
+
+public:
+  void Reserve(std::size_t polyline_count, std::size_t vertex_count)
+  {
+    m_Commands.reserve(polyline_count);
+    m_Vertices.reserve(vertex_count);
+  }
+  void Clear() noexcept
+  {
+    m_Vertices.clear();
+    m_Commands.clear();
+  }
+  template<std::ranges::input_range Path>
+    requires std::convertible_to<std::ranges::range_reference_t<Path>,
+      Vertex>
+  void Add(Path &&path)
+  {
+    auto const First = m_Vertices.size();
+    for (auto &&Point : path) { m_Vertices.push_back(Point); }
+    auto const Count = m_Vertices.size() - First;
+    if (Count < 2) {
+      m_Vertices.resize(First);
+      return;
+    }
+    m_Commands.push_back({ .Count = static_cast<GLuint>(Count),
+      .InstanceCount = 1,
+      .First = static_cast<GLuint>(First),
+      .BaseInstance = static_cast<GLuint>(m_Commands.size()) });
+  }
+
+  [[nodiscard]] auto GetVertices() const noexcept -> std::span<Vertex const>
+  {
+    return m_Vertices;
+  }
+  [[nodiscard]] auto GetCommands() const noexcept
+    -> std::span<DrawArraysIndirectCommand const>
+  {
+    return m_Commands;
+  }
+  [[nodiscard]] auto GetPolylineCount() const noexcept -> std::size_t
+  {
+    return m_Commands.size();
+  }
+
+  // Element indices drawing the same polylines as one GL_LINE_STRIP, with
+  // kPrimitiveRestartIndex between consecutive polylines
+  [[nodiscard]] auto GetRestartIndices() const -> std::vector<GLuint>
+  {
+    std::vector<GLuint> Indices;
+    Indices.reserve(m_Vertices.size() + m_Commands.size());
+    for (auto const &Command : m_Commands) {
+      if (!Indices.empty()) { Indices.push_back(kPrimitiveRestartIndex); }
+      for (GLuint Index = 0; Index < Command.Count; ++Index) {
+        Indices.push_back(Command.First + Index);
+      }
+    }
+    return Indices;
+  }
+};
+
+// How a PolylineRenderer submits its batch
+enum class PolylineSubmission : std::uint8_t {
+  // One glMultiDrawArraysIndirect call, OpenGL 4.3 and later
+  MultiDrawIndirect,
+  // One glDrawElements call over restart-separated indices, OpenGL 3.1
+  PrimitiveRestart,
+};
+
+// Draws a whole PolylineBatch as line strips with a single draw call. The
+// caller's program reads the vertex attributes laid out by VertexLayout;
+// with multi-draw indirect, gl_DrawID and gl_BaseInstance identify the
+// polyline being drawn. Drawers made from a renderer point at it, so it
+// cannot be moved.
+class PolylineRenderer
+{
+  PolylineSubmission m_Submission;
+  GLuint m_VertexArray{};
+  GLuint m_VertexBuffer{};
+  std::size_t m_VertexCapacity{};
+  // Indirect commands or restart indices, depending on m_Submission
+  GLuint m_DrawBuffer{};
+  std::size_t m_DrawCapacity{};
+  GLsizei m_DrawCount{};
+
+  void UploadVertices(std::span<std::byte const> bytes,
+    std::span<VertexAttribute const> attributes,
+    GLsizei stride);
+  void UploadCommands(std::span<DrawArraysIndirectCommand const> commands);
+  void UploadIndices(std::span<GLuint const> indices);
+
+public:
+  // Chooses multi-draw indirect when the context supports it
+  PolylineRenderer();
+  explicit PolylineRenderer(PolylineSubmission submission);
+  PolylineRenderer(PolylineRenderer const &) = delete;
+  PolylineRenderer(PolylineRenderer &&) = delete;
+  auto operator=(PolylineRenderer const &) -> PolylineRenderer & = delete;
+  auto operator=(PolylineRenderer &&) -> PolylineRenderer & = delete;
+  ~PolylineRenderer();
+
+  template<vertex Vertex> void Upload(PolylineBatch<Vertex> const &batch)
+  {
+    UploadVertices(std::as_bytes(batch.GetVertices()),
+      VertexLayout<Vertex>::kAttributes,
+      VertexLayout<Vertex>::kStride);
+    if (m_Submission == PolylineSubmission::MultiDrawIndirect) {
+      UploadCommands(batch.GetCommands());
+    } else {
+      UploadIndices(batch.GetRestartIndices());
+    }
+  }
+
+  [[nodiscard]] auto GetSubmission() const noexcept -> PolylineSubmission
+  {
+    return m_Submission;
+  }
+  [[nodiscard]] auto GetVertexArray() const noexcept -> GLuint
+  {
+    return m_VertexArray;
+  }
+
+  // Binds the vertex array and draws every uploaded polyline
+  void Draw() const noexcept;
+  // Drawer for drawer sets and pipelines that draws the latest upload with
+  // program; both have to outlive it
+  [[nodiscard]] auto MakeDrawer(Program const &program) const -> OpenGLDrawer;
+};
+}// namespace renderer::gl
@@ -0,0 +1,119 @@
+#pragma once
+#include <glad/glad.h>//
+//
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <renderer/buffer/vertexLayout.hpp>
+#include <renderer/point/point.hpp>
+#include <renderer/shader/shader.hpp>
+#include <renderer/vector/vector.hpp>
+#include <ranges>
+#include <span>
+
+namespace renderer::gl {
+
+enum class MarkerShape : std::uint8_t { Circle, Cross, Square };
+
+// Vertices drawn per marker: one quad, or two thin ones for a cross
+constexpr auto GetMarkerVertexCount(MarkerShape shape) noexcept -> GLsizei
+{
+  return shape == MarkerShape::Cross ? 12 : 6;
+}
+
+template<typename T>
+concept marker_point = std::same_as<T, renderer::Point2<float>>
+                       || std::same_as<T, renderer::Point3<float>>;
+
+struct MarkerStyle
+{
+  MarkerShape Shape{ MarkerShape::Circle };
+  // Width of a marker in pixels, independent of the transform
+  float Size{ 5.0F };
+};
+
+// Draws every renderer::Point of a buffer as a marker in one instanced draw
+// call. Each point is one instance whose position and colour are read as
+// per-instance attributes; the vertex shader expands it into the marker
+// geometry, so the buffer holds nothing but the points themselves.
+//
+//   Markers.Upload(RayHits);
+//   Markers.SetViewport(width, height);
+//   Markers.Draw({ .Shape = MarkerShape::Cross, .Size = 7.0F });
+class MarkerRenderer
+{
+  Program m_Program;
+  UniformHandle m_TransformUniform;
+  UniformHandle m_PixelSizeUniform;
+  UniformHandle m_MarkerSizeUniform;
+  UniformHandle m_ShapeUniform;
+  GLuint m_VertexArray{};
+  // Owned instance buffer filled by Upload, grown but never shrunk
+  GLuint m_Buffer{};
+  std::size_t m_Capacity{};
+  GLsizei m_InstanceCount{};
+
+  void SetInstances(GLuint buffer,
+    GLintptr offset,
+    GLsizei count,
+    std::span<VertexAttribute const> attributes,
+    GLsizei stride) noexcept;
+  void UploadInstances(std::span<std::byte const> bytes,
+    GLsizei count,
+    std::span<VertexAttribute const> attributes,
+    GLsizei stride);
+  void Release() noexcept;
+
+public:
+  // Sized for the current GL viewport until SetViewport is called
+  MarkerRenderer();
+  MarkerRenderer(MarkerRenderer const &) = delete;
+  MarkerRenderer(MarkerRenderer &&other) noexcept;
+  auto operator=(MarkerRenderer const &) -> MarkerRenderer & = delete;
+  auto operator=(MarkerRenderer &&other) noexcept -> MarkerRenderer &;
+  ~MarkerRenderer() { Release(); }
+
+  // Copies points into the renderer's own buffer. Two dimensional points are
+  // drawn at depth 0.
+  template<std::ranges::contiguous_range Points>
+    requires(std::ranges::sized_range<Points>
+             && marker_point<std::ranges::range_value_t<Points>>)
+  void Upload(Points const &points)
+  {
+    using Layout = VertexLayout<std::ranges::range_value_t<Points>>;
+    UploadInstances(std::as_bytes(std::span(points)),
+      static_cast<GLsizei>(std::ranges::size(points)),
+      Layout::kAttributes,
+      Layout::kStride);
+  }
+  // Draws count points of type Point stored at offset in a buffer owned by
+  // someone else, e.g. the output of a compute pass or a StreamingBuffer
+  // region, without copying them
+  template<marker_point Point>
+  void UseInstances(GLuint buffer, GLintptr offset, GLsizei count) noexcept
+  {
+    using Layout = VertexLayout<Point>;
+    SetInstances(
+      buffer, offset, count, Layout::kAttributes, Layout::kStride);
+  }
+
+  // Maps point coordinates to clip space as position * scale + offset
+  void SetTransform(renderer::Vector2<float> scale,
+    renderer::Vector2<float> offset);
+  // Framebuffer size in pixels, used to keep markers a fixed size on screen
+  void SetViewport(GLsizei width, GLsizei height);
+
+  [[nodiscard]] auto GetInstanceCount() const noexcept -> GLsizei
+  {
+    return m_InstanceCount;
+  }
+  [[nodiscard]] auto GetProgram() noexcept -> Program & { return m_Program; }
+  [[nodiscard]] auto GetVertexArray() const noexcept -> GLuint
+  {
+    return m_VertexArray;
+  }
+
+  // Binds the marker program and vertex array and draws every instance
+  void Draw(MarkerStyle style);
+};
+}// namespace renderer::gl
@@ -0,0 +1,473 @@
+#pragma once
+#include <glad/glad.h>//
+//
+#include <array>
+#include <cassert>
+#include <compare>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <renderer/buffer/vertexLayout.hpp>
+#include <renderer/colour/colour.hpp>
+#include <renderer/point/point.hpp>
+#include <renderer/utils/alignedAllocator.hpp>
+#include <renderer/vector/vector.hpp>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace renderer {
+
+template<typename T, std::size_t Dimension> class PointCloud;
+
+// Stands in for a Point stored across a PointCloud's arrays. Accessors
+// mirror Point and RGBColour; converting to Point copies it out and
+// assigning a Point, or another reference, writes it back. Like a Point &,
+// a reference is never rebound by assignment.
+template<typename T, std::size_t Dimension, bool Const> class PointReference
+{
+  using Cloud = std::conditional_t<Const,
+    PointCloud<T, Dimension> const,
+    PointCloud<T, Dimension>>;
+  template<typename U>
+  using Reference = std::conditional_t<Const, U const &, U &>;
+
+  Cloud *m_Cloud;
+  std::size_t m_Index;
+
+public:
+  constexpr PointReference(Cloud &cloud, std::size_t index) noexcept
+    : m_Cloud(&cloud), m_Index(index)
+  {}
+  PointReference(PointReference const &) = default;
+
+  [[nodiscard]] auto Position(std::size_t axis) const noexcept -> Reference<T>
+  {
+    return m_Cloud->GetCoordinates(axis)[m_Index];
+  }
+  [[nodiscard]] auto X() const noexcept -> Reference<T>
+    requires(Dimension > 0)
+  {
+    return Position(0);
+  }
+  [[nodiscard]] auto Y() const noexcept -> Reference<T>
+    requires(Dimension > 1)
+  {
+    return Position(1);
+  }
+  [[nodiscard]] auto Z() const noexcept -> Reference<T>
+    requires(Dimension > 2)
+  {
+    return Position(2);
+  }
+  [[nodiscard]] auto W() const noexcept -> Reference<T>
+    requires(Dimension > 3)
+  {
+    return Position(3);
+  }
+  [[nodiscard]] auto Red() const noexcept -> Reference<renderer::Red>
+  {
+    return m_Cloud->GetReds()[m_Index];
+  }
+  [[nodiscard]] auto Green() const noexcept -> Reference<renderer::Green>
+  {
+    return m_Cloud->GetGreens()[m_Index];
+  }
+  [[nodiscard]] auto Blue() const noexcept -> Reference<renderer::Blue>
+  {
+    return m_Cloud->GetBlues()[m_Index];
+  }
+
+  // NOLINTNEXTLINE(hicpp-explicit-conversions)
+  [[nodiscard]] operator Point<T, Dimension>() const noexcept
+  {
+    Point<T, Dimension> Result{};
+    for (std::size_t Axis = 0; Axis < Dimension; ++Axis) {
+      Result.m_PositionVector.m_Values[Axis] = Position(Axis);
+    }
+    Result.m_ColourOfPoint.Red() = Red();
+    Result.m_ColourOfPoint.Green() = Green();
+    Result.m_ColourOfPoint.Blue() = Blue();
+    return Result;
+  }
+  // Writes through to the cloud, like assigning to a Point &
+  auto operator=(Point<T, Dimension> const &point) const noexcept
+    -> PointReference const &
+    requires(!Const)
+  {
+    for (std::size_t Axis = 0; Axis < Dimension; ++Axis) {
+      Position(Axis) = point.m_PositionVector.m_Values[Axis];
+    }
+    Red() = point.m_ColourOfPoint.Red();
+    Green() = point.m_ColourOfPoint.Green();
+    Blue() = point.m_ColourOfPoint.Blue();
+    return *this;
+  }
+  // Copies the point other refers to, so Cloud[0] = Cloud[1] copies a point
+  auto operator=(PointReference const &other) const noexcept
+    -> PointReference const &
+    requires(!Const)
+  {
+    return *this = static_cast<Point<T, Dimension>>(other);
+  }
+  auto operator=(PointReference<T, Dimension, !Const> const &other)
+    const noexcept -> PointReference const &
+    requires(!Const)
+  {
+    return *this = static_cast<Point<T, Dimension>>(other);
+  }
+
+  // Exchanges the points two references refer to, for std::ranges::swap and
+  // the algorithms that permute Points()
+  friend void swap(PointReference const &first,
+    PointReference const &second) noexcept
+    requires(!Const)
+  {
+    Point<T, Dimension> const Temporary = first;
+    first = second;
+    second = Temporary;
+  }
+};
+
+// Random access iterator over a PointCloud yielding PointReferences. Its
+// value type is Point, so algorithms that set an element aside, such as
+// std::ranges::sort, copy the point out rather than keep a reference.
+template<typename T, std::size_t Dimension, bool Const> class PointIterator
+{
+  using Cloud = std::conditional_t<Const,
+    PointCloud<T, Dimension> const,
+    PointCloud<T, Dimension>>;
+
+  Cloud *m_Cloud{};
+  std::ptrdiff_t m_Index{};
+
+public:
+  using value_type = Point<T, Dimension>;
+  using difference_type = std::ptrdiff_t;
+  using iterator_concept = std::random_access_iterator_tag;
+  // Dereferencing gives a proxy, which legacy iterators do not allow
+  using iterator_category = std::input_iterator_tag;
+
+  PointIterator() = default;
+  constexpr PointIterator(Cloud &cloud, difference_type index) noexcept
+    : m_Cloud(&cloud), m_Index(index)
+  {}
+
+  [[nodiscard]] auto operator*() const noexcept
+    -> PointReference<T, Dimension, Const>
+  {
+    return { *m_Cloud, static_cast<std::size_t>(m_Index) };
+  }
+  [[nodiscard]] auto operator[](difference_type offset) const noexcept
+    -> PointReference<T, Dimension, Const>
+  {
+    return *(*this + offset);
+  }
+
+  auto operator++() noexcept -> PointIterator &
+  {
+    ++m_Index;
+    return *this;
+  }
+  auto operator++(int) noexcept -> PointIterator
+  {
+    auto Previous = *this;
+    ++m_Index;
+    return Previous;
+  }
+  auto operator--() noexcept -> PointIterator &
+  {
+    --m_Index;
+    return *this;
+  }
+  auto operator--(int) noexcept -> PointIterator
+  {
+    auto Previous = *this;
+    --m_Index;
+    return Previous;
+  }
+  auto operator+=(difference_type offset) noexcept -> PointIterator &
+  {
+    m_Index += offset;
+    return *this;
+  }
+  auto operator-=(difference_type offset) noexcept -> PointIterator &
+  {
+    m_Index -= offset;
+    return *this;
+  }
+  [[nodiscard]] friend auto operator+(PointIterator iterator,
+    difference_type offset) noexcept -> PointIterator
+  {
+    return iterator += offset;
+  }
+  [[nodiscard]] friend auto operator+(difference_type offset,
+    PointIterator iterator) noexcept -> PointIterator
+  {
+    return iterator += offset;
+  }
+  [[nodiscard]] friend auto operator-(PointIterator iterator,
+    difference_type offset) noexcept -> PointIterator
+  {
+    return iterator -= offset;
+  }
+  [[nodiscard]] friend auto operator-(PointIterator const &first,
+    PointIterator const &second) noexcept -> difference_type
+  {
+    return first.m_Index - second.m_Index;
+  }
+  [[nodiscard]] auto operator==(PointIterator const &other) const noexcept
+    -> bool
+  {
+    return m_Index == other.m_Index;
+  }
+  [[nodiscard]] auto operator<=>(PointIterator const &other) const noexcept
+  {
+    return m_Index <=> other.m_Index;
+  }
+};
+
+// Structure of arrays counterpart to std::vector<Point<T, Dimension>>: every
+// coordinate and every colour channel has its own contiguous, cache line
+// aligned array, so a pass over positions never loads colours and the
+// loops vectorise.
+//
+// The arrays upload into a buffer as they are and are read by one scalar
+// attribute each, see SetupVertexArray.
+template<typename T, std::size_t Dimension> class PointCloud
+{
+public:
+  static constexpr std::size_t kAlignment = 64;
+  template<typename U>
+  using Array = std::vector<U, AlignedAllocator<U, kAlignment>>;
+
+private:
+  std::array<Array<T>, Dimension> m_Coordinates;
+  Array<renderer::Red> m_Reds;
+  Array<renderer::Green> m_Greens;
+  Array<renderer::Blue> m_Blues;
+
+  template<typename U>
+  static auto Aligned(U *data) noexcept -> U *
+  {
+    return std::assume_aligned<kAlignment>(data);
+  }
+
+public:
+  using Reference = PointReference<T, Dimension, false>;
+  using ConstReference = PointReference<T, Dimension, true>;
+
+  PointCloud() = default;
+  explicit PointCloud(std::span<Point<T, Dimension> const> points)
+  {
+    Resize(points.size());
+    for (std::size_t Index = 0; Index < points.size(); ++Index) {
+      (*this)[Index] = points[Index];
+    }
+  }
+
+  [[nodiscard]] auto GetSize() const noexcept -> std::size_t
+  {
+    return m_Reds.size();
+  }
+  [[nodiscard]] auto IsEmpty() const noexcept -> bool
+  {
+    return m_Reds.empty();
+  }
+  void Reserve(std::size_t count)
+  {
+    for (auto &Coordinates : m_Coordinates) { Coordinates.reserve(count); }
+    m_Reds.reserve(count);
+    m_Greens.reserve(count);
+    m_Blues.reserve(count);
+  }
+  // New points are at the origin and black
+  void Resize(std::size_t count)
+  {
+    for (auto &Coordinates : m_Coordinates) { Coordinates.resize(count); }
+    m_Reds.resize(count);
+    m_Greens.resize(count);
+    m_Blues.resize(count);
+  }
+  void Clear() noexcept { Resize(0); }
+  void PushBack(Point<T, Dimension> const &point)
+  {
+    for (std::size_t Axis = 0; Axis < Dimension; ++Axis) {
+      m_Coordinates[Axis].push_back(point.m_PositionVector.m_Values[Axis]);
+    }
+    m_Reds.push_back(point.m_ColourOfPoint.Red());
+    m_Greens.push_back(point.m_ColourOfPoint.Green());
+    m_Blues.push_back(point.m_ColourOfPoint.Blue());
+  }
+
+  [[nodiscard]] auto operator[](std::size_t index) noexcept -> Reference
+  {
+    assert(index < GetSize());
+    return { *this, index };
+  }
+  [[nodiscard]] auto operator[](std::size_t index) const noexcept
+    -> ConstReference
+  {
+    assert(index < GetSize());
+    return { *this, index };
+  }
+  // Random access range of point references, zipping all of the arrays.
+  // It can be sorted and otherwise permuted like a range of Points.
+  [[nodiscard]] auto Points() noexcept
+    -> std::ranges::subrange<PointIterator<T, Dimension, false>>
+  {
+    using Iterator = PointIterator<T, Dimension, false>;
+    return { Iterator(*this, 0),
+      Iterator(*this, static_cast<std::ptrdiff_t>(GetSize())) };
+  }
+  [[nodiscard]] auto Points() const noexcept
+    -> std::ranges::subrange<PointIterator<T, Dimension, true>>
+  {
+    using Iterator = PointIterator<T, Dimension, true>;
+    return { Iterator(*this, 0),
+      Iterator(*this, static_cast<std::ptrdiff_t>(GetSize())) };
+  }
+
+  [[nodiscard]] auto GetCoordinates(std::size_t axis) noexcept -> std::span<T>
+  {
+    return { Aligned(m_Coordinates[axis].data()), GetSize() };
+  }
+  [[nodiscard]] auto GetCoordinates(std::size_t axis) const noexcept
+    -> std::span<T const>
+  {
+    return { Aligned(m_Coordinates[axis].data()), GetSize() };
+  }
+  [[nodiscard]] auto GetReds() noexcept -> std::span<renderer::Red>
+  {
+    return m_Reds;
+  }
+  [[nodiscard]] auto GetReds() const noexcept
+    -> std::span<renderer::Red const>
+  {
+    return m_Reds;
+  }
+  [[nodiscard]] auto GetGreens() noexcept -> std::span<renderer::Green>
+  {
+    return m_Greens;
+  }
+  [[nodiscard]] auto GetGreens() const noexcept
+    -> std::span<renderer::Green const>
+  {
+    return m_Greens;
+  }
+  [[nodiscard]] auto GetBlues() noexcept -> std::span<renderer::Blue>
+  {
+    return m_Blues;
+  }
+  [[nodiscard]] auto GetBlues() const noexcept
+    -> std::span<renderer::Blue const>
+  {
+    return m_Blues;
+  }
+
+  // position = position * scale + offset, per axis
+  void Transform(Vector<T, Dimension> const &scale,
+    Vector<T, Dimension> const &offset) noexcept
+  {
+    auto const Count = GetSize();
+    for (std::size_t Axis = 0; Axis < Dimension; ++Axis) {
+      auto *const Coordinates = Aligned(m_Coordinates[Axis].data());
+      auto const Scale = scale.m_Values[Axis];
+      auto const Offset = offset.m_Values[Axis];
+      for (std::size_t Index = 0; Index < Count; ++Index) {
+        Coordinates[Index] = Coordinates[Index] * Scale + Offset;
+      }
+    }
+  }
+  // position = rows * position + offset, such as a rotation about the
+  // origin followed by a translation
+  void Transform(std::array<Vector<T, Dimension>, Dimension> const &rows,
+    Vector<T, Dimension> const &offset) noexcept
+  {
+    std::array<T *, Dimension> Coordinates{};
+    for (std::size_t Axis = 0; Axis < Dimension; ++Axis) {
+      Coordinates[Axis] = Aligned(m_Coordinates[Axis].data());
+    }
+    auto const Count = GetSize();
+    for (std::size_t Index = 0; Index < Count; ++Index) {
+      std::array<T, Dimension> Input{};
+      for (std::size_t Axis = 0; Axis < Dimension; ++Axis) {
+        Input[Axis] = Coordinates[Axis][Index];
+      }
+      for (std::size_t Row = 0; Row < Dimension; ++Row) {
+        T Sum = offset.m_Values[Row];
+        for (std::size_t Axis = 0; Axis < Dimension; ++Axis) {
+          Sum += rows[Row].m_Values[Axis] * Input[Axis];
+        }
+        Coordinates[Row][Index] = Sum;
+      }
+    }
+  }
+
+  // Bytes written by Upload: the coordinate arrays, then red, green and blue
+  [[nodiscard]] auto GetUploadSize() const noexcept -> std::size_t
+  {
+    return GetSize() * (Dimension * sizeof(T) + 3);
+  }
+  // Copies every array into buffer at offset, back to back, with one
+  // glNamedBufferSubData per array and no repacking. buffer needs
+  // GL_DYNAMIC_STORAGE_BIT and GetUploadSize bytes from offset.
+  void Upload(GLuint buffer, GLintptr offset = 0) const noexcept
+  {
+    auto Write = [&]<typename U>(std::span<U const> array) {
+      auto const Bytes = std::as_bytes(array);
+      glNamedBufferSubData(
+        buffer, offset, static_cast<GLsizeiptr>(Bytes.size()), Bytes.data());
+      offset += static_cast<GLintptr>(Bytes.size());
+    };
+    for (std::size_t Axis = 0; Axis < Dimension; ++Axis) {
+      Write(GetCoordinates(Axis));
+    }
+    Write(GetReds());
+    Write(GetGreens());
+    Write(GetBlues());
+  }
+  // Reads an Upload at offset in buffer through Dimension + 3 scalar
+  // attributes from first_location: one per coordinate, then the normalised
+  // red, green and blue. Each takes its own binding from first_binding. A
+  // vertex shader puts them back together, e.g. in 3D
+  //   layout(location = 0) in float x; ... layout(location = 5) in float b;
+  //   gl_Position = uTransform * vec4(x, y, z, 1.0);
+  void SetupVertexArray(GLuint vertex_array,
+    GLuint buffer,
+    GLintptr offset = 0,
+    GLuint first_location = 0,
+    GLuint first_binding = 0) const noexcept
+  {
+    using Component = gl::_impl::ComponentType<T>;
+    static_assert(Component::kSupported, "T has no vertex attribute type");
+    constexpr std::array kCoordinate{ gl::VertexAttribute{
+      1, Component::kType, false, Component::kKind, 0 } };
+    constexpr std::array kChannel{ gl::VertexAttribute{
+      1, GL_UNSIGNED_BYTE, true, gl::AttributeKind::Float, 0 } };
+    auto Stream = 0U;
+    auto Bind = [&](std::span<gl::VertexAttribute const> attribute,
+                  std::size_t size) {
+      gl::SetupVertexArray(vertex_array,
+        buffer,
+        attribute,
+        static_cast<GLsizei>(size),
+        { .Offset = offset,
+          .BindingIndex = first_binding + Stream,
+          .FirstLocation = first_location + Stream });
+      offset += static_cast<GLintptr>(size * GetSize());
+      ++Stream;
+    };
+    for (std::size_t Axis = 0; Axis < Dimension; ++Axis) {
+      Bind(kCoordinate, sizeof(T));
+    }
+    for (std::size_t Channel = 0; Channel < 3; ++Channel) {
+      Bind(kChannel, 1);
+    }
+  }
+};
+
+template<typename T> using PointCloud2 = PointCloud<T, 2>;
+template<typename T> using PointCloud3 = PointCloud<T, 3>;
+}// namespace renderer
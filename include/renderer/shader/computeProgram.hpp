@@ -0,0 +1,85 @@
+#pragma once
+#include <glad/glad.h>//
+//
+#include <array>
+#include <renderer/shader/shader.hpp>
+#include <string_view>
+
+namespace renderer::gl {
+
+// Size of a compute dispatch, either in work groups or in invocations
+struct DispatchSize
+{
+  GLuint X{ 1 };
+  GLuint Y{ 1 };
+  GLuint Z{ 1 };
+
+  constexpr auto operator==(DispatchSize const &) const -> bool = default;
+};
+
+// Work groups of local_size needed to cover invocations. The last group
+// along each axis may run past the end, so kernels check their bounds.
+constexpr auto GetWorkGroupCount(DispatchSize invocations,
+  DispatchSize local_size) noexcept -> DispatchSize
+{
+  auto Cover = [](GLuint count, GLuint size) {
+    return (count + size - 1) / size;
+  };
+  return { Cover(invocations.X, local_size.X),
+    Cover(invocations.Y, local_size.Y),
+    Cover(invocations.Z, local_size.Z) };
+}
+
+// Compute shader program. Its local work group size is reflected once after
+// linking, so callers can dispatch per item (ray, pixel, ...) without
+// repeating the layout(local_size_*) of the shader.
+//
+// Results written through storage buffers or images are only visible to
+// later GL commands after a matching glMemoryBarrier. Dispatch takes the
+// barrier bits for how the results are consumed next, e.g.
+//   GL_SHADER_STORAGE_BARRIER_BIT      another shader reads the buffer
+//   GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT the buffer is drawn as vertices
+//   GL_BUFFER_UPDATE_BARRIER_BIT       the buffer is read back
+//   GL_TEXTURE_FETCH_BARRIER_BIT       the image is sampled
+class ComputeProgram
+{
+  Program m_Program;
+  DispatchSize m_LocalSize{};
+
+public:
+  explicit ComputeProgram(std::string_view source);
+
+  [[nodiscard]] auto GetProgram() noexcept -> Program & { return m_Program; }
+  [[nodiscard]] auto GetProgram() const noexcept -> Program const &
+  {
+    return m_Program;
+  }
+  [[nodiscard]] auto GetLocalSize() const noexcept -> DispatchSize
+  {
+    return m_LocalSize;
+  }
+
+  // Binds the whole of buffer, or size bytes from offset, to the
+  // layout(binding = binding) buffer block
+  static void BindStorageBuffer(GLuint binding,
+    GLuint buffer,
+    GLintptr offset = 0,
+    GLsizeiptr size = 0) noexcept;
+  // Binds level of texture to the layout(binding = unit) image, with access
+  // GL_READ_ONLY, GL_WRITE_ONLY or GL_READ_WRITE
+  static void BindImage(GLuint unit,
+    GLuint texture,
+    GLenum access,
+    GLenum format,
+    GLint level = 0) noexcept;
+
+  // Runs groups work groups, then issues barriers (if any)
+  void Dispatch(DispatchSize groups, GLbitfield barriers) const noexcept;
+  // Runs at least invocations invocations, rounded up to whole work groups
+  void DispatchInvocations(DispatchSize invocations,
+    GLbitfield barriers) const noexcept
+  {
+    Dispatch(GetWorkGroupCount(invocations, m_LocalSize), barriers);
+  }
+};
+}// namespace renderer::gl
@@ -0,0 +1,66 @@
+#pragma once
+#include <glad/glad.h>//
+//
+#include <initializer_list>
+#include <renderer/shader/shader.hpp>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace renderer::gl {
+
+// GL_KHR_parallel_shader_compile is not part of the generated loader
+inline constexpr GLenum kCompletionStatusKHR = 0x91B1;
+
+struct ShaderSource
+{
+  GLenum Type{};
+  std::string_view Source{};
+};
+
+// True when the GLFW context current on the calling thread exposes KHR or
+// ARB parallel_shader_compile
+[[nodiscard]] auto SupportsParallelShaderCompile() -> bool;
+// Asks the driver for up to count compiler threads (0xFFFFFFFF lets it pick),
+// loading the entry point through load_proc, e.g. glfwGetProcAddress.
+// Returns false when the extension is unavailable.
+auto SetMaxShaderCompilerThreads(GLADloadproc load_proc,
+  GLuint count = 0xFFFFFFFF) -> bool;
+
+// Program whose units are compiled and linked without waiting for the
+// driver. Construct every PendingProgram up front, keep rendering, and call
+// Get once IsReady reports completion; Get on an unfinished program blocks
+// like the synchronous Program constructor. Without parallel compile support
+// IsReady is always true and the work happens when Get queries the result.
+class [[nodiscard]] PendingProgram
+{
+  GLuint m_ProgramID{};
+  std::vector<GLuint> m_ShaderIDs{};
+  bool m_CanPoll{};
+
+  void Release() noexcept;
+
+public:
+  explicit PendingProgram(std::span<ShaderSource const> sources);
+  explicit PendingProgram(std::initializer_list<ShaderSource> sources)
+    : PendingProgram(
+        std::span<ShaderSource const>(sources.begin(), sources.end()))
+  {}
+  PendingProgram(PendingProgram const &) = delete;
+  PendingProgram(PendingProgram &&other) noexcept;
+  auto operator=(PendingProgram const &) -> PendingProgram & = delete;
+  auto operator=(PendingProgram &&other) noexcept -> PendingProgram &;
+  ~PendingProgram() { Release(); }
+
+  // False once Get has taken the program
+  [[nodiscard]] auto IsValid() const noexcept -> bool
+  {
+    return m_ProgramID != 0;
+  }
+  // Never blocks
+  [[nodiscard]] auto IsReady() const noexcept -> bool;
+  // Waits for the link, throwing CompilationError with the failing unit's
+  // log, and hands over the program
+  [[nodiscard]] auto Get() -> Program;
+};
+}// namespace renderer::gl
@@ -0,0 +1,74 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <optional>
+#include <renderer/utils/hash.hpp>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace renderer::gl {
+
+struct ShaderDefine
+{
+  std::string Name;
+  std::string Value{ "1" };
+
+  auto operator==(ShaderDefine const &) const -> bool = default;
+};
+
+// Set of preprocessor defines selecting one permutation of a shader. Defines
+// are kept sorted by name and the permutation key is updated as they are
+// set, so looking a permutation up never rehashes or allocates.
+class ShaderDefines
+{
+  std::vector<ShaderDefine> m_Defines{};
+  std::uint64_t m_Key{ utils::kFnv1aOffsetBasis };
+
+  void UpdateKey() noexcept;
+
+public:
+  ShaderDefines() = default;
+  ShaderDefines(std::initializer_list<ShaderDefine> defines);
+
+  // Adds name or replaces its value
+  auto Set(std::string_view name, std::string_view value = "1")
+    -> ShaderDefines &;
+  auto Unset(std::string_view name) -> ShaderDefines &;
+  [[nodiscard]] auto Get() const noexcept -> std::span<ShaderDefine const>
+  {
+    return m_Defines;
+  }
+  // Equal for equal sets, whatever order the defines were set in
+  [[nodiscard]] auto GetKey() const noexcept -> std::uint64_t { return m_Key; }
+
+  friend auto operator==(ShaderDefines const &, ShaderDefines const &)
+    -> bool = default;
+};
+
+// Hashes a define set by its precomputed key, for maps keyed by the set
+struct ShaderDefinesHash
+{
+  auto operator()(ShaderDefines const &defines) const noexcept -> std::size_t
+  {
+    return static_cast<std::size_t>(defines.GetKey());
+  }
+};
+
+// Returns the source of a shader named by an #include directive, or nothing
+// when there is no such shader
+using IncludeResolver =
+  std::function<std::optional<std::string>(std::string_view name)>;
+
+// Expands #include "name" lines through resolve (each file at most once) and
+// inserts defines right after the #version line. #line directives keep
+// compiler messages pointing at the original line numbers, with source string
+// 0 for source and 1, 2, ... for included files in the order they appear.
+// Throws CompilationError for unknown or recursive includes.
+auto PreprocessShader(std::string_view source,
+  ShaderDefines const &defines,
+  IncludeResolver const &resolve = {}) -> std::string;
+}// namespace renderer::gl
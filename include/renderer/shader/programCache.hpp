@@ -0,0 +1,60 @@
+#pragma once
+#include <glad/glad.h>//
+//
+#include <concepts>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <initializer_list>
+#include <optional>
+#include <renderer/shader/shader.hpp>
+#include <string_view>
+#include <utility>
+
+namespace renderer::gl {
+
+// Per-user cache directory for application: XDG_CACHE_HOME or ~/.cache on
+// Unix, LOCALAPPDATA on Windows, falling back to the temp directory
+[[nodiscard]] auto GetUserCacheDirectory(std::string_view application)
+  -> std::filesystem::path;
+
+// On-disk cache of linked program binaries. Entries are keyed by a hash of
+// the shader sources and of the driver's vendor, renderer and version
+// strings, so a driver update simply misses the cache. Construct it with a
+// current GL context.
+class ProgramBinaryCache
+{
+  std::filesystem::path m_Directory;
+  std::uint64_t m_DriverHash{};
+  bool m_Enabled{};
+
+  [[nodiscard]] auto GetEntryPath(std::uint64_t key) const
+    -> std::filesystem::path;
+
+public:
+  explicit ProgramBinaryCache(std::filesystem::path directory);
+
+  // False when the driver offers no binary formats; loads then always miss
+  [[nodiscard]] auto IsEnabled() const noexcept -> bool { return m_Enabled; }
+  [[nodiscard]] auto GetKey(std::initializer_list<std::string_view> sources)
+    const noexcept -> std::uint64_t;
+  // Returns nothing on a miss, or when the driver rejects the stored binary
+  [[nodiscard]] auto Load(std::uint64_t key) const -> std::optional<Program>;
+  // Failures to write the cache are logged and otherwise ignored
+  void Store(std::uint64_t key, Program const &program) const;
+
+  // Loads the program for sources from the cache, or builds it with build
+  // (compiling from those same sources) and stores the result
+  template<typename Builder>
+    requires std::same_as<std::invoke_result_t<Builder>, Program>
+  auto LoadOrBuild(std::initializer_list<std::string_view> sources,
+    Builder &&build) -> Program
+  {
+    auto const Key = GetKey(sources);
+    if (auto Cached = Load(Key)) { return std::move(*Cached); }
+    auto Built = std::invoke(std::forward<Builder>(build));
+    Store(Key, Built);
+    return Built;
+  }
+};
+}// namespace renderer::gl
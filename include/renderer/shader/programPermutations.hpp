@@ -0,0 +1,60 @@
+#pragma once
+#include <glad/glad.h>//
+//
+#include <cstddef>
+#include <initializer_list>
+#include <optional>
+#include <renderer/shader/pendingProgram.hpp>
+#include <renderer/shader/preprocessor.hpp>
+#include <renderer/shader/shader.hpp>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace renderer::gl {
+
+// Programs built from one set of shader sources under different
+// ShaderDefines, so variants are specialised at compile time instead of
+// branching on uniforms. Each permutation is preprocessed and compiled the
+// first time it is asked for and reused afterwards; references to returned
+// programs stay valid for the lifetime of the cache.
+class ProgramPermutations
+{
+  struct Unit
+  {
+    GLenum Type;
+    std::string Source;
+  };
+  struct Permutation
+  {
+    std::optional<Program> Built{};
+    std::optional<PendingProgram> Pending{};
+  };
+  std::vector<Unit> m_Units{};
+  IncludeResolver m_Resolve;
+  // Keyed by the define set itself, so two sets whose keys collide still get
+  // their own programs
+  std::unordered_map<ShaderDefines, Permutation, ShaderDefinesHash>
+    m_Permutations{};
+
+  auto Find(ShaderDefines const &defines) -> Permutation &;
+  auto Finish(ShaderDefines const &defines, Permutation &permutation)
+    -> Program &;
+
+public:
+  explicit ProgramPermutations(std::initializer_list<ShaderSource> units,
+    IncludeResolver resolve = {});
+
+  // Starts compiling a permutation in the background, e.g. while loading
+  void Prepare(ShaderDefines const &defines) { (void)Find(defines); }
+  // Compiles the permutation if needed, waiting for it. Throws
+  // CompilationError, after which the permutation can be requested again.
+  [[nodiscard]] auto Get(ShaderDefines const &defines) -> Program &;
+  // Never blocks; nullptr while the permutation is still compiling
+  [[nodiscard]] auto TryGet(ShaderDefines const &defines) -> Program *;
+  [[nodiscard]] auto Size() const noexcept -> std::size_t
+  {
+    return m_Permutations.size();
+  }
+};
+}// namespace renderer::gl
@@ -0,0 +1,147 @@
+#pragma once
+#include <glad/glad.h>//
+//
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <renderer/shader/shader.hpp>
+#include <string_view>
+#include <utility>
+
+namespace renderer::gl {
+
+// Single-stage program linked with GL_PROGRAM_SEPARABLE, to be combined with
+// other stages in a ProgramPipeline instead of linked into every Program
+// that uses it. Uniforms are set on GetProgram() as usual.
+class StageProgram
+{
+  Program m_Program;
+  GLenum m_ShaderType;
+
+  StageProgram(Program program, GLenum shader_type) noexcept
+    : m_Program(std::move(program)), m_ShaderType(shader_type)
+  {}
+
+public:
+  // Compiles and links source, throwing CompilationError on failure
+  template<GLenum ShaderType>
+    requires IsShaderType<ShaderType>
+  [[nodiscard]] static auto Create(std::string_view source) -> StageProgram
+  {
+    return { Program::CreateSeparable(ShaderType, source), ShaderType };
+  }
+
+  [[nodiscard]] auto GetProgram() noexcept -> Program & { return m_Program; }
+  [[nodiscard]] auto GetProgram() const noexcept -> Program const &
+  {
+    return m_Program;
+  }
+  [[nodiscard]] auto GetShaderType() const noexcept -> GLenum
+  {
+    return m_ShaderType;
+  }
+  // The GL_*_SHADER_BIT for glUseProgramStages
+  [[nodiscard]] auto GetStageBit() const noexcept -> GLbitfield;
+};
+
+// Program pipeline object combining stage programs at bind time
+class ProgramPipeline
+{
+  GLuint m_PipelineID{};
+
+public:
+  ProgramPipeline() noexcept { glCreateProgramPipelines(1, &m_PipelineID); }
+  template<std::same_as<StageProgram>... Stages>
+  explicit ProgramPipeline(Stages const &...stages) noexcept
+    : ProgramPipeline()
+  {
+    (UseStage(stages), ...);
+  }
+  ProgramPipeline(ProgramPipeline const &) = delete;
+  ProgramPipeline(ProgramPipeline &&other) noexcept
+    : m_PipelineID(std::exchange(other.m_PipelineID, 0))
+  {}
+  auto operator=(ProgramPipeline const &) -> ProgramPipeline & = delete;
+  auto operator=(ProgramPipeline &&other) noexcept -> ProgramPipeline &
+  {
+    if (this != &other) {
+      glDeleteProgramPipelines(1, &m_PipelineID);
+      m_PipelineID = std::exchange(other.m_PipelineID, 0);
+    }
+    return *this;
+  }
+  ~ProgramPipeline() { glDeleteProgramPipelines(1, &m_PipelineID); }
+
+  [[nodiscard]] auto GetPipelineID() const noexcept -> GLuint
+  {
+    return m_PipelineID;
+  }
+  void UseStage(StageProgram const &stage) const noexcept
+  {
+    glUseProgramStages(
+      m_PipelineID, stage.GetStageBit(), stage.GetProgram().GetProgramID());
+  }
+  // A bound pipeline only takes effect while no program is in use
+  void Bind() const noexcept
+  {
+    glUseProgram(0);
+    glBindProgramPipeline(m_PipelineID);
+  }
+  // Checks that the stages' interfaces match, throwing CompilationError with
+  // the driver's log if they do not
+  void Validate() const;
+};
+
+// Stage indices used to key ProgramPipelineCache
+inline constexpr std::size_t kPipelineStageCount = 6;
+auto GetPipelineStageIndex(GLenum shader_type) -> std::size_t;
+
+// Pipelines keyed by the combination of stage programs they use, so each
+// combination is assembled once however often it is drawn. Programs are
+// identified by serial rather than GL name, so a stage program created in
+// place of a destroyed one never picks up the old program's pipeline.
+class ProgramPipelineCache
+{
+  using Key = std::array<std::uint64_t, kPipelineStageCount>;
+  std::map<Key, ProgramPipeline> m_Pipelines{};
+
+public:
+  template<std::same_as<StageProgram>... Stages>
+  [[nodiscard]] auto Get(Stages const &...stages) -> ProgramPipeline &
+  {
+    Key StageKey{};
+    ((StageKey[GetPipelineStageIndex(stages.GetShaderType())] =
+         stages.GetProgram().GetSerial()),
+      ...);
+    auto Found = m_Pipelines.find(StageKey);
+    if (Found == m_Pipelines.end()) {
+      Found = m_Pipelines.emplace(StageKey, ProgramPipeline(stages...)).first;
+    }
+    return Found->second;
+  }
+  [[nodiscard]] auto Size() const noexcept -> std::size_t
+  {
+    return m_Pipelines.size();
+  }
+  // Releases the pipelines using the program with this serial; call it when
+  // a stage program is replaced or destroyed, e.g. on reload. Returns the
+  // number of pipelines released.
+  auto Evict(std::uint64_t serial) noexcept -> std::size_t
+  {
+    // Zero marks unused stages, and moved-from programs
+    if (serial == 0) { return 0; }
+    return std::erase_if(m_Pipelines, [serial](auto const &entry) {
+      return std::ranges::find(entry.first, serial) != entry.first.end();
+    });
+  }
+  auto Evict(StageProgram const &stage) noexcept -> std::size_t
+  {
+    return Evict(stage.GetProgram().GetSerial());
+  }
+  // Releases every pipeline, including those of destroyed stage programs
+  void Clear() noexcept { m_Pipelines.clear(); }
+};
+}// namespace renderer::gl
@@ -0,0 +1,55 @@
+#pragma once
+#include <glad/glad.h>//
+//
+#include <filesystem>
+#include <optional>
+#include <renderer/shader/pendingProgram.hpp>
+#include <renderer/shader/shader.hpp>
+#include <renderer/utils/fileWatcher.hpp>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace renderer::gl {
+
+struct ShaderFile
+{
+  GLenum Type{};
+  std::filesystem::path Path{};
+  std::string Source{};
+};
+
+// Program rebuilt from its shader files whenever they change. Rebuilds are
+// compiled in the background through PendingProgram and swapped in by
+// Update, which the render thread calls between frames; a rebuild that fails
+// to compile is logged and the last good program stays in use. Each swap
+// gives the program a new ID and invalidates its UniformHandles.
+class ReloadableProgram
+{
+  std::vector<ShaderFile> m_Files;
+  std::optional<Program> m_Program{};
+  std::optional<PendingProgram> m_Pending{};
+
+  void StartBuild();
+
+public:
+  // Builds from files unless a program built from the same sources is given
+  explicit ReloadableProgram(std::vector<ShaderFile> files,
+    std::optional<Program> built = std::nullopt);
+
+  // Takes new sources for any of the files among changes and swaps in a
+  // finished rebuild. Never blocks; returns true when the program changed.
+  auto Update(std::span<utils::ChangedFile const> changes = {}) -> bool;
+  // False until the first build finishes
+  [[nodiscard]] auto HasProgram() const noexcept -> bool
+  {
+    return m_Program.has_value();
+  }
+  [[nodiscard]] auto GetProgram() -> Program & { return m_Program.value(); }
+  // Sources of the latest build, finished or not
+  [[nodiscard]] auto GetFiles() const noexcept -> std::span<ShaderFile const>
+  {
+    return m_Files;
+  }
+};
+}// namespace renderer::gl
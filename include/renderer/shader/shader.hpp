@@ -5,13 +5,18 @@
 #include <array>
 #include <concepts>
 #include <cstddef>
+#include <cstdint>
 #include <fmt/core.h>
 #include <fmt/format.h>
 #include <functional>
+#include <optional>
 #include <renderer/error/error.hpp>
+#include <renderer/utils/frameStatistics.hpp>
+#include <span>
 #include <string>
 #include <string_view>
 #include <utility>
+#include <vector>
 namespace renderer::gl {
 
 template<GLenum Type>
@@ -29,6 +34,9 @@ concept ValidUniformSpec =
   && (std::same_as<Type, unsigned int> || std::same_as<Type, float>
       || std::same_as<Type, int> || std::same_as<Type, double>);
 
+auto GetShaderInfoLog(GLuint shader_id) -> std::string;
+auto GetProgramInfoLog(GLuint program_id) -> std::string;
+
 template<GLenum ShaderType>
   requires IsShaderType<ShaderType>
 class ShaderUnit
@@ -49,25 +57,19 @@ public:
   {
     // NOLINTNEXTLINE
     auto ShaderSource = reinterpret_cast<GLchar const *>(source.data());
+    // source need not be null terminated
+    auto const SourceLength = static_cast<GLint>(source.size());
     // Compile shader
-    glShaderSource(m_ShaderID, 1, &ShaderSource, nullptr);
+    glShaderSource(m_ShaderID, 1, &ShaderSource, &SourceLength);
     glCompileShader(m_ShaderID);
 
     // Check if successful
     GLint CompiledSuccessfully{};
     glGetShaderiv(m_ShaderID, GL_COMPILE_STATUS, &CompiledSuccessfully);
     if (CompiledSuccessfully != GL_TRUE) {
-      GLsizei LogLength{};
-      glGetShaderiv(m_ShaderID, GL_INFO_LOG_LENGTH, &LogLength);
-      std::string Message{};
-      Message.reserve(static_cast<std::size_t>(LogLength));
-      glGetShaderInfoLog(m_ShaderID,
-        NULL,
-        nullptr,
-        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
-        reinterpret_cast<GLchar *>(Message.data()));
+      auto Message = GetShaderInfoLog(m_ShaderID);
       glDeleteShader(m_ShaderID);
-      throw renderer::CompilationError(Message);
+      throw renderer::CompilationError(std::move(Message));
     }
   }
   constexpr ~ShaderUnit() { glDeleteShader(m_ShaderID); }
@@ -95,112 +97,230 @@ void AddShaderUnits(unsigned int program_id,
   glAttachShader(program_id, first.GetShaderID());
   AddShaderUnits(program_id, std::move(shader_units)...);
 }
-// Main program class
-class Program
+// Information about an active uniform, gathered once after linking
+struct UniformInfo
 {
-  GLuint m_ProgramID{ glCreateProgram() };
+  std::string Name;
+  GLint Location{ -1 };
+  GLenum Type{};
+  GLint Size{};
+};
 
+// Resolved uniform of a specific Program. Setting through a handle skips the
+// name lookup entirely.
+class UniformHandle
+{
+  GLint m_Location{ -1 };
+  std::uint32_t m_Index{};
+  friend class Program;
+  constexpr UniformHandle(GLint location, std::uint32_t index) noexcept
+    : m_Location(location), m_Index(index)
+  {}
 
 public:
-  template<renderer::gl::ShaderType... Args>
-  explicit Program(Args... shader_units)
+  UniformHandle() = default;
+  [[nodiscard]] constexpr auto GetLocation() const noexcept -> GLint
   {
-    AddShaderUnits(m_ProgramID, std::move(shader_units)...);
-    glLinkProgram(m_ProgramID);
-    GLint ProgramLinked{};
-    glGetProgramiv(m_ProgramID, GL_LINK_STATUS, &ProgramLinked);
-    if (ProgramLinked != GL_TRUE) {
-      GLsizei LogLength{};
-      glGetProgramiv(m_ProgramID, GL_INFO_LOG_LENGTH, &LogLength);
-      std::string Message{};
-      Message.reserve(static_cast<std::size_t>(LogLength));
-      glGetProgramInfoLog(m_ProgramID,
-        NULL,
-        nullptr,
-        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
-        reinterpret_cast<GLchar *>(Message.data()));
-      glDeleteProgram(m_ProgramID);
-      throw renderer::CompilationError(Message);
-    }
+    return m_Location;
   }
-  void Use() const noexcept { glUseProgram(m_ProgramID); }
+};
+
+// Driver-specific program binary, as returned by glGetProgramBinary
+struct ProgramBinary
+{
+  GLenum Format{};
+  std::vector<std::byte> Data{};
+};
+
+auto IsUniformTypeCompatible(GLenum declared_type,
+  GLenum component_type,
+  std::size_t size) noexcept -> bool;
+auto GetUniformTypeString(GLenum type) -> char const *;
+
+// Main program class
+class Program
+{
+  // Last value uploaded to a uniform, large enough for a dvec4
+  struct UniformShadow
+  {
+    std::array<std::byte, 4 * sizeof(double)> Value{};
+    bool Valid{};
+  };
+  GLuint m_ProgramID{ glCreateProgram() };
+  // Unlike program names, which the driver reuses, never repeats
+  std::uint64_t m_Serial{ NextSerial() };
+  // Sorted by name
+  std::vector<UniformInfo> m_Uniforms{};
+  // Parallel to m_Uniforms
+  std::vector<UniformShadow> m_UniformShadows{};
+  std::size_t m_UniformUploads{};
+  std::size_t m_UniformUploadsElided{};
+
+  // Records value as the uniform's shadow. Returns false, counting the call
+  // as elided, when the uniform already holds exactly these bytes.
+  auto UpdateUniformShadow(std::uint32_t index,
+    std::span<std::byte const> value) noexcept -> bool;
+  static auto NextSerial() noexcept -> std::uint64_t;
+
+  Program() = default;
+  explicit Program(GLuint linked_program_id) noexcept
+    : m_ProgramID(linked_program_id)
+  {}
+  friend class PendingProgram;
+  friend class StageProgram;
+  // Compiles and links a single-stage GL_PROGRAM_SEPARABLE program
+  static auto CreateSeparable(GLenum shader_type, std::string_view source)
+    -> Program;
+  // Takes ownership of an already linked program and reflects its uniforms
+  static auto AdoptLinked(GLuint program_id) -> Program;
+  // Links the attached units, throwing on failure, then reflects uniforms
+  void Link();
+  void ReflectUniforms();
   template<std::size_t Size, typename Type>
-  void SetUniform(std::string const &name, Type value)
-    requires(ValidUniformSpec<Size, Type> && (Size == 1))
+  void UploadUniform(GLint location,
+    std::array<Type, Size> const &values) const noexcept
   {
-    auto Location = glGetUniformLocation(m_ProgramID, name.data());
-    if (Location == -1) {
-      throw renderer::UniformError(fmt::format("\"{}\"", name));
-    }
+    // Direct state access: the program need not be current, and separable
+    // stage programs are set the same way
     if constexpr (std::same_as<Type, float>) {
-      glUniform1f(Location, value);
+      if constexpr (Size == 1) {
+        glProgramUniform1fv(m_ProgramID, location, 1, values.data());
+      } else if constexpr (Size == 2) {
+        glProgramUniform2fv(m_ProgramID, location, 1, values.data());
+      } else if constexpr (Size == 3) {
+        glProgramUniform3fv(m_ProgramID, location, 1, values.data());
+      } else {
+        glProgramUniform4fv(m_ProgramID, location, 1, values.data());
+      }
     } else if constexpr (std::same_as<Type, int>) {
-      glUniform1i(Location, value);
+      if constexpr (Size == 1) {
+        glProgramUniform1iv(m_ProgramID, location, 1, values.data());
+      } else if constexpr (Size == 2) {
+        glProgramUniform2iv(m_ProgramID, location, 1, values.data());
+      } else if constexpr (Size == 3) {
+        glProgramUniform3iv(m_ProgramID, location, 1, values.data());
+      } else {
+        glProgramUniform4iv(m_ProgramID, location, 1, values.data());
+      }
     } else if constexpr (std::same_as<Type, unsigned int>) {
-      glUniform1ui(Location, value);
+      if constexpr (Size == 1) {
+        glProgramUniform1uiv(m_ProgramID, location, 1, values.data());
+      } else if constexpr (Size == 2) {
+        glProgramUniform2uiv(m_ProgramID, location, 1, values.data());
+      } else if constexpr (Size == 3) {
+        glProgramUniform3uiv(m_ProgramID, location, 1, values.data());
+      } else {
+        glProgramUniform4uiv(m_ProgramID, location, 1, values.data());
+      }
     } else if constexpr (std::same_as<Type, double>) {
-      glUniform1d(Location, value);
+      if constexpr (Size == 1) {
+        glProgramUniform1dv(m_ProgramID, location, 1, values.data());
+      } else if constexpr (Size == 2) {
+        glProgramUniform2dv(m_ProgramID, location, 1, values.data());
+      } else if constexpr (Size == 3) {
+        glProgramUniform3dv(m_ProgramID, location, 1, values.data());
+      } else {
+        glProgramUniform4dv(m_ProgramID, location, 1, values.data());
+      }
     }
   }
-  template<std::size_t Size, typename Type>
-  void SetUniform(std::string const &name, Type value1, Type value2)
-    requires(ValidUniformSpec<Size, Type> && (Size == 2))
+  template<typename Type> static constexpr auto ComponentType() -> GLenum
   {
-    auto Location = glGetUniformLocation(m_ProgramID, name.data());
-    if (Location == -1) {
-      throw renderer::UniformError(fmt::format("\"{}\"", name));
-    }
     if constexpr (std::same_as<Type, float>) {
-      glUniform2f(Location, value1, value2);
+      return GL_FLOAT;
     } else if constexpr (std::same_as<Type, int>) {
-      glUniform2i(Location, value1, value2);
+      return GL_INT;
     } else if constexpr (std::same_as<Type, unsigned int>) {
-      glUniform2ui(Location, value1, value2);
-    } else if constexpr (std::same_as<Type, double>) {
-      glUniform2d(Location, value1, value2);
+      return GL_UNSIGNED_INT;
+    } else {
+      return GL_DOUBLE;
     }
   }
+  // Debug builds verify the handle belongs to this program and that the C++
+  // Size/Type matches the GLSL declaration
   template<std::size_t Size, typename Type>
-  void
-    SetUniform(std::string const &name, Type value1, Type value2, Type value3)
-    requires(ValidUniformSpec<Size, Type> && (Size == 3))
+  void CheckUniform([[maybe_unused]] UniformHandle handle) const
   {
-    auto Location = glGetUniformLocation(m_ProgramID, name.data());
-    if (Location == -1) {
-      throw renderer::UniformError(fmt::format("\"{}\"", name));
+#ifndef NDEBUG
+    if (handle.m_Index >= m_Uniforms.size()
+        || m_Uniforms[handle.m_Index].Location != handle.m_Location) {
+      throw renderer::UniformError(
+        fmt::format("Uniform handle at location {} does not belong to program "
+                    "{}",
+          handle.m_Location,
+          m_ProgramID));
     }
-    if constexpr (std::same_as<Type, float>) {
-      glUniform3f(Location, value1, value2, value3);
-    } else if constexpr (std::same_as<Type, int>) {
-      glUniform3i(Location, value1, value2, value3);
-    } else if constexpr (std::same_as<Type, unsigned int>) {
-      glUniform3ui(Location, value1, value2, value3);
-    } else if constexpr (std::same_as<Type, double>) {
-      glUniform3d(Location, value1, value2, value3);
+    auto const &Uniform = m_Uniforms[handle.m_Index];
+    if (!IsUniformTypeCompatible(Uniform.Type, ComponentType<Type>(), Size)) {
+      throw renderer::UniformError(
+        fmt::format("\"{}\" is declared as {} but was set with {} x {}",
+          Uniform.Name,
+          GetUniformTypeString(Uniform.Type),
+          Size,
+          GetUniformTypeString(ComponentType<Type>())));
     }
+#endif
   }
+
+public:
+  template<renderer::gl::ShaderType... Args>
+  explicit Program(Args... shader_units)
+  {
+    AddShaderUnits(m_ProgramID, std::move(shader_units)...);
+    Link();
+  }
+  [[nodiscard]] constexpr auto GetProgramID() const noexcept -> unsigned int
+  {
+    return m_ProgramID;
+  }
+  // Identifies this program for the lifetime of the process, so caches keyed
+  // by it cannot mistake a later program for a destroyed one. Zero once
+  // moved from.
+  [[nodiscard]] constexpr auto GetSerial() const noexcept -> std::uint64_t
+  {
+    return m_Serial;
+  }
+  void Use() const noexcept { glUseProgram(m_ProgramID); }
+  // Loads a binary from GetBinary. Returns nothing when the driver rejects
+  // it, e.g. after a driver update, so the caller can compile from source.
+  [[nodiscard]] static auto FromBinary(ProgramBinary const &binary)
+    -> std::optional<Program>;
+  [[nodiscard]] auto GetBinary() const -> std::optional<ProgramBinary>;
+  // Active uniforms, sorted by name
+  [[nodiscard]] auto GetUniforms() const noexcept
+    -> std::span<UniformInfo const>
+  {
+    return m_Uniforms;
+  }
+  [[nodiscard]] auto FindUniform(std::string_view name) const noexcept
+    -> std::optional<UniformHandle>;
+  // Throws UniformError when the uniform is not active in this program
+  [[nodiscard]] auto GetUniformHandle(std::string_view name) const
+    -> UniformHandle;
   template<std::size_t Size, typename Type>
-  void SetUniform(std::string const &name,
-    Type value1,
-    Type value2,
-    Type value3,
-    Type value4)
-    requires(ValidUniformSpec<Size, Type> && (Size == 4))
+  void SetUniform(UniformHandle handle,
+    std::convertible_to<Type> auto... values)
+    requires(ValidUniformSpec<Size, Type> && (sizeof...(values) == Size))
   {
-    auto Location = glGetUniformLocation(m_ProgramID, name.data());
-    if (Location == -1) {
-      throw renderer::UniformError(fmt::format("\"{}\" was not found", name));
-    }
-    if constexpr (std::same_as<Type, float>) {
-      glUniform4f(Location, value1, value2, value3, value4);
-    } else if constexpr (std::same_as<Type, int>) {
-      glUniform4i(Location, value1, value2, value3, value4);
-    } else if constexpr (std::same_as<Type, unsigned int>) {
-      glUniform4ui(Location, value1, value2, value3, value4);
-    } else if constexpr (std::same_as<Type, double>) {
-      glUniform4d(Location, value1, value2, value3, value4);
+    CheckUniform<Size, Type>(handle);
+    std::array<Type, Size> const Values{ static_cast<Type>(values)... };
+    if (UpdateUniformShadow(
+          handle.m_Index, std::as_bytes(std::span{ Values }))) {
+      UploadUniform<Size, Type>(handle.m_Location, Values);
     }
   }
+  template<std::size_t Size, typename Type>
+  void SetUniform(std::string_view name,
+    std::convertible_to<Type> auto... values)
+    requires(ValidUniformSpec<Size, Type> && (sizeof...(values) == Size))
+  {
+    SetUniform<Size, Type>(GetUniformHandle(name), values...);
+  }
+  // Forget the shadowed values, e.g. after setting uniforms with raw GL calls
+  void InvalidateUniformShadows() noexcept;
+  // Adds the uniform upload counters gathered since the last call to
+  // statistics, then resets them
+  void CollectStatistics(FrameStatistics &statistics) noexcept;
   template<typename Func, typename... Params>
     requires std::invocable<Func, unsigned int, Params...>
   auto UseProgramInFunction(Func &&function, Params... parameters) noexcept(
@@ -211,9 +331,28 @@ public:
       std::forward<Params...>(parameters...));
   }
   Program(Program const &) = delete;
-  Program(Program &&) = default;
+  Program(Program &&other) noexcept
+    : m_ProgramID(std::exchange(other.m_ProgramID, 0)),
+      m_Serial(std::exchange(other.m_Serial, 0)),
+      m_Uniforms(std::move(other.m_Uniforms)),
+      m_UniformShadows(std::move(other.m_UniformShadows)),
+      m_UniformUploads(std::exchange(other.m_UniformUploads, 0)),
+      m_UniformUploadsElided(std::exchange(other.m_UniformUploadsElided, 0))
+  {}
   auto operator=(Program const &) -> Program & = delete;
-  auto operator=(Program &&) -> Program & = default;
+  auto operator=(Program &&other) noexcept -> Program &
+  {
+    if (this != &other) {
+      glDeleteProgram(m_ProgramID);
+      m_ProgramID = std::exchange(other.m_ProgramID, 0);
+      m_Serial = std::exchange(other.m_Serial, 0);
+      m_Uniforms = std::move(other.m_Uniforms);
+      m_UniformShadows = std::move(other.m_UniformShadows);
+      m_UniformUploads = std::exchange(other.m_UniformUploads, 0);
+      m_UniformUploadsElided = std::exchange(other.m_UniformUploadsElided, 0);
+    }
+    return *this;
+  }
   ~Program() { glDeleteProgram(m_ProgramID); }
 };
 }// namespace renderer::gl
@@ -0,0 +1,294 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <renderer/utils/layoutProbe.hpp>
+#include <renderer/vector/vector.hpp>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// Compile-time std140 layout rules (OpenGL 4.6 core, section 7.6.2.2) for
+// C++ structs that are uploaded byte for byte into uniform buffers.
+namespace renderer::gl::std140 {
+
+// Explicit filler bytes, used where std140 leaves a gap the C++ layout would
+// not. Padding occupies exactly Bytes bytes with no alignment requirement.
+template<std::size_t Bytes> struct Padding
+{
+  std::array<std::byte, Bytes> m_Bytes{};
+};
+
+// Specialise for every struct used as (or inside) a uniform block, listing
+// pointers to all of its members in declaration order:
+//   template<> struct renderer::gl::std140::Members<Lens>
+//   {
+//     static constexpr std::tuple kList{ &Lens::Radius, &Lens::Index };
+//   };
+template<typename T> struct Members;
+
+namespace _impl {
+  template<typename T> struct MemberType;
+  template<typename Class, typename T> struct MemberType<T Class::*>
+  {
+    using Type = T;
+  };
+
+  constexpr auto AlignUp(std::size_t value, std::size_t alignment) noexcept
+    -> std::size_t
+  {
+    return (value + alignment - 1) / alignment * alignment;
+  }
+
+  template<typename T>
+  concept scalar = std::same_as<T, float> || std::same_as<T, int>
+                   || std::same_as<T, unsigned int> || std::same_as<T, double>;
+
+  template<typename T> struct IsArray : std::false_type
+  {
+  };
+  template<typename T, std::size_t Length>
+  struct IsArray<std::array<T, Length>> : std::true_type
+  {
+  };
+  template<typename T> struct IsPadding : std::false_type
+  {
+  };
+  template<std::size_t Bytes>
+  struct IsPadding<Padding<Bytes>> : std::true_type
+  {
+  };
+}// namespace _impl
+
+template<typename T>
+concept structure = requires {
+  { Members<T>::kList };
+} && std::is_standard_layout_v<T> && std::is_trivially_copyable_v<T>;
+
+struct TypeLayout
+{
+  std::size_t BaseAlignment;
+  std::size_t Size;
+};
+
+template<typename T> consteval auto LayoutOf() -> TypeLayout;
+
+namespace _impl {
+  template<typename T> struct LayoutRule
+  {
+    static constexpr bool kSupported = false;
+  };
+  template<scalar T> struct LayoutRule<T>
+  {
+    static constexpr bool kSupported = true;
+    static consteval auto Get() -> TypeLayout
+    {
+      return { sizeof(T), sizeof(T) };
+    }
+  };
+  template<scalar T, std::size_t Dimension>
+    requires(Dimension >= 2 && Dimension <= 4)
+  struct LayoutRule<renderer::Vector<T, Dimension>>
+  {
+    static constexpr bool kSupported = true;
+    static consteval auto Get() -> TypeLayout
+    {
+      // vec3 is aligned like vec4 but only occupies three components
+      return { (Dimension == 2 ? 2 : 4) * sizeof(T), Dimension * sizeof(T) };
+    }
+  };
+  template<typename T, std::size_t Length>
+    requires(LayoutRule<T>::kSupported && !IsPadding<T>::value)
+  struct LayoutRule<std::array<T, Length>>
+  {
+    static constexpr bool kSupported = true;
+    static consteval auto Get() -> TypeLayout
+    {
+      // Array elements are rounded up to the alignment of a vec4
+      auto const Element = LayoutOf<T>();
+      auto const Alignment = AlignUp(Element.BaseAlignment, 16);
+      return { Alignment, Length * AlignUp(Element.Size, Alignment) };
+    }
+  };
+  template<std::size_t Bytes> struct LayoutRule<Padding<Bytes>>
+  {
+    static constexpr bool kSupported = true;
+    static consteval auto Get() -> TypeLayout { return { 1, Bytes }; }
+  };
+  template<structure T> struct LayoutRule<T>
+  {
+    static constexpr bool kSupported = true;
+    static consteval auto Get() -> TypeLayout;
+  };
+}// namespace _impl
+
+template<typename T>
+concept member = _impl::LayoutRule<T>::kSupported;
+
+template<typename T> consteval auto LayoutOf() -> TypeLayout
+{
+  static_assert(member<T>,
+    "Type has no std140 layout; use float, int, unsigned int, double, "
+    "renderer::Vector, std::array, std140::Padding or a struct with "
+    "std140::Members");
+  return _impl::LayoutRule<T>::Get();
+}
+
+template<structure T>
+inline constexpr std::size_t kMemberCount =
+  std::tuple_size_v<std::remove_cvref_t<decltype(Members<T>::kList)>>;
+
+template<structure T, std::size_t Index>
+using MemberTypeAt = typename _impl::MemberType<
+  std::tuple_element_t<Index,
+    std::remove_cvref_t<decltype(Members<T>::kList)>>>::Type;
+
+// Offsets the members of T would get under std140
+template<structure T>
+consteval auto Std140Offsets() -> std::array<std::size_t, kMemberCount<T>>
+{
+  std::array<std::size_t, kMemberCount<T>> Offsets{};
+  std::size_t End = 0;
+  [&]<std::size_t... Index>(std::index_sequence<Index...>) {
+    ((Offsets[Index] = _impl::AlignUp(
+        End, LayoutOf<MemberTypeAt<T, Index>>().BaseAlignment),
+       End = Offsets[Index] + LayoutOf<MemberTypeAt<T, Index>>().Size),
+      ...);
+  }(std::make_index_sequence<kMemberCount<T>>{});
+  return Offsets;
+}
+
+// Offsets the C++ compiler gives the members of a standard-layout T, which
+// places each member at the next multiple of its alignment
+template<structure T>
+consteval auto NativeOffsets() -> std::array<std::size_t, kMemberCount<T>>
+{
+  std::array<std::size_t, kMemberCount<T>> Offsets{};
+  std::size_t End = 0;
+  [&]<std::size_t... Index>(std::index_sequence<Index...>) {
+    ((Offsets[Index] =
+         _impl::AlignUp(End, alignof(MemberTypeAt<T, Index>)),
+       End = Offsets[Index] + sizeof(MemberTypeAt<T, Index>)),
+      ...);
+  }(std::make_index_sequence<kMemberCount<T>>{});
+  return Offsets;
+}
+
+namespace _impl {
+  // Whether value, read from a probe, holds the probe bytes expected at its
+  // NativeOffsets. Structs and arrays are compared element by element so
+  // their padding is never read.
+  template<typename T>
+  constexpr auto ReadsProbe(T const &value,
+    std::span<std::byte const> expected) -> bool
+  {
+    if constexpr (structure<T>) {
+      auto const Offsets = NativeOffsets<T>();
+      bool Matches = true;
+      [&]<std::size_t... Index>(std::index_sequence<Index...>) {
+        ((Matches = Matches
+                    && ReadsProbe(value.*std::get<Index>(Members<T>::kList),
+                      expected.subspan(
+                        Offsets[Index], sizeof(MemberTypeAt<T, Index>)))),
+          ...);
+      }(std::make_index_sequence<kMemberCount<T>>{});
+      return Matches;
+    } else if constexpr (IsArray<T>::value) {
+      using Element = typename T::value_type;
+      for (std::size_t Index = 0; Index < value.size(); ++Index) {
+        if (!ReadsProbe(value[Index],
+              expected.subspan(Index * sizeof(Element), sizeof(Element)))) {
+          return false;
+        }
+      }
+      return true;
+    } else {
+      return std::ranges::equal(
+        std::bit_cast<std::array<std::byte, sizeof(T)>>(value), expected);
+    }
+  }
+}// namespace _impl
+
+// True when Members<T> lists every member of T in declaration order, so
+// NativeOffsets describes the real object. Reading each member from a probe
+// catches reordered members that leave the total size unchanged.
+template<structure T> consteval auto ListsAllMembers() -> bool
+{
+  std::size_t End = 0;
+  std::size_t Alignment = 1;
+  [&]<std::size_t... Index>(std::index_sequence<Index...>) {
+    ((End = _impl::AlignUp(End, alignof(MemberTypeAt<T, Index>))
+            + sizeof(MemberTypeAt<T, Index>),
+       Alignment = std::max(Alignment, alignof(MemberTypeAt<T, Index>))),
+      ...);
+  }(std::make_index_sequence<kMemberCount<T>>{});
+  if (_impl::AlignUp(End, Alignment) != sizeof(T) || Alignment != alignof(T)) {
+    return false;
+  }
+  auto const Bytes = utils::MakeProbeBytes<T>();
+  return _impl::ReadsProbe(
+    std::bit_cast<T>(Bytes), std::span<std::byte const>(Bytes));
+}
+
+inline constexpr std::size_t kNoMismatch =
+  std::numeric_limits<std::size_t>::max();
+
+template<structure T> consteval auto FirstMismatch() -> std::size_t;
+
+// True when a member of type T occupies the same bytes in C++ as in std140:
+// same size, and for arrays and nested structs the same inner layout
+template<typename T> consteval auto IsVerbatim() -> bool
+{
+  if (sizeof(T) != LayoutOf<T>().Size) { return false; }
+  if constexpr (structure<T>) {
+    return FirstMismatch<T>() == kNoMismatch;
+  } else if constexpr (_impl::IsArray<T>::value) {
+    return IsVerbatim<typename T::value_type>();
+  } else {
+    return true;
+  }
+}
+
+// Index of the first member whose C++ offset or layout differs from std140,
+// or kNoMismatch
+template<structure T> consteval auto FirstMismatch() -> std::size_t
+{
+  auto const Expected = Std140Offsets<T>();
+  auto const Actual = NativeOffsets<T>();
+  std::array<bool, kMemberCount<T>> Matches{};
+  [&]<std::size_t... Index>(std::index_sequence<Index...>) {
+    ((Matches[Index] = Expected[Index] == Actual[Index]
+                       && IsVerbatim<MemberTypeAt<T, Index>>()),
+      ...);
+  }(std::make_index_sequence<kMemberCount<T>>{});
+  for (std::size_t Index = 0; Index < Matches.size(); ++Index) {
+    if (!Matches[Index]) { return Index; }
+  }
+  return kNoMismatch;
+}
+
+template<structure T>
+consteval auto _impl::LayoutRule<T>::Get() -> TypeLayout
+{
+  // Structures are aligned like a vec4 and padded to that alignment
+  std::size_t Alignment = 16;
+  [&]<std::size_t... Index>(std::index_sequence<Index...>) {
+    ((Alignment = std::max(Alignment,
+        AlignUp(LayoutOf<MemberTypeAt<T, Index>>().BaseAlignment, 16))),
+      ...);
+  }(std::make_index_sequence<kMemberCount<T>>{});
+  constexpr auto kLast = kMemberCount<T> - 1;
+  auto const End = Std140Offsets<T>()[kLast]
+                   + LayoutOf<MemberTypeAt<T, kLast>>().Size;
+  return { Alignment, AlignUp(End, Alignment) };
+}
+
+// A struct that can be copied verbatim into a std140 uniform block
+template<typename T>
+concept block = structure<T> && ListsAllMembers<T>()
+                && FirstMismatch<T>() == kNoMismatch;
+}// namespace renderer::gl::std140
@@ -0,0 +1,79 @@
+#pragma once
+#include <glad/glad.h>//
+//
+#include <cstddef>
+#include <renderer/shader/shader.hpp>
+#include <renderer/shader/std140.hpp>
+#include <string_view>
+#include <utility>
+
+namespace renderer::gl {
+
+// Points the uniform block block_name of program at binding_point. Throws
+// UniformError when the block is missing or, in debug builds, when its size
+// differs from expected_size.
+void BindUniformBlock(Program const &program,
+  std::string_view block_name,
+  GLuint binding_point,
+  std::size_t expected_size);
+
+// Uniform buffer holding a T whose C++ layout matches std140, so the whole
+// block is uploaded with a single buffer update
+template<std140::block T> class UniformBlock
+{
+  static constexpr std::size_t kSize = std140::LayoutOf<T>().Size;
+  GLuint m_BufferID{};
+  GLuint m_BindingPoint{};
+
+public:
+  explicit UniformBlock(GLuint binding_point, T const &value = {})
+    : m_BindingPoint(binding_point)
+  {
+    glCreateBuffers(1, &m_BufferID);
+    glNamedBufferStorage(m_BufferID,
+      static_cast<GLsizeiptr>(kSize),
+      nullptr,
+      GL_DYNAMIC_STORAGE_BIT);
+    Update(value);
+    BindBuffer();
+  }
+  [[nodiscard]] constexpr auto GetBufferID() const noexcept -> GLuint
+  {
+    return m_BufferID;
+  }
+  [[nodiscard]] constexpr auto GetBindingPoint() const noexcept -> GLuint
+  {
+    return m_BindingPoint;
+  }
+  void Update(T const &value) const noexcept
+  {
+    glNamedBufferSubData(
+      m_BufferID, 0, static_cast<GLsizeiptr>(sizeof(T)), &value);
+  }
+  // Re-attaches the buffer to its binding point, if something else took it
+  void BindBuffer() const noexcept
+  {
+    glBindBufferBase(GL_UNIFORM_BUFFER, m_BindingPoint, m_BufferID);
+  }
+  void Bind(Program const &program, std::string_view block_name) const
+  {
+    BindUniformBlock(program, block_name, m_BindingPoint, kSize);
+  }
+  UniformBlock(UniformBlock const &) = delete;
+  UniformBlock(UniformBlock &&other) noexcept
+    : m_BufferID(std::exchange(other.m_BufferID, 0)),
+      m_BindingPoint(other.m_BindingPoint)
+  {}
+  auto operator=(UniformBlock const &) -> UniformBlock & = delete;
+  auto operator=(UniformBlock &&other) noexcept -> UniformBlock &
+  {
+    if (this != &other) {
+      glDeleteBuffers(1, &m_BufferID);
+      m_BufferID = std::exchange(other.m_BufferID, 0);
+      m_BindingPoint = other.m_BindingPoint;
+    }
+    return *this;
+  }
+  ~UniformBlock() { glDeleteBuffers(1, &m_BufferID); }
+};
+}// namespace renderer::gl
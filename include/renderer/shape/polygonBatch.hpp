@@ -0,0 +1,142 @@
+#pragma once
+#include <glad/glad.h>//
+//
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <renderer/buffer/vertexLayout.hpp>
+#include <renderer/drawer/openGlDrawer.hpp>
+#include <renderer/point/point.hpp>
+#include <renderer/shader/shader.hpp>
+#include <renderer/shape/shape.hpp>
+#include <renderer/shape/triangulation.hpp>
+#include <span>
+#include <vector>
+
+namespace renderer::gl {
+
+// Triangulates polygons of any size, such as prisms, lens cross-sections
+// and mirror outlines, into one shared vertex array and one index array,
+// so the whole scene is a single GL_TRIANGLES draw. Each polygon's corners
+// are its vertices, so a corner's colour is the colour of that vertex.
+template<typename T> class PolygonBatch
+{
+  std::vector<Point2<T>> m_Vertices;
+  std::vector<GLuint> m_Indices;
+  std::vector<std::uint32_t> m_Scratch;
+  std::size_t m_PolygonCount{};
+
+  void AppendIndices(GLuint first, std::span<std::uint32_t const> local)
+  {
+    for (auto const Index : local) { m_Indices.push_back(first + Index); }
+  }
+
+public:
+  // vertex_count is the total number of corners in polygon_count polygons
+  void Reserve(std::size_t polygon_count, std::size_t vertex_count)
+  {
+    m_Vertices.reserve(vertex_count);
+    if (vertex_count > 2 * polygon_count) {
+      m_Indices.reserve(3 * (vertex_count - 2 * polygon_count));
+    }
+  }
+  void Clear() noexcept
+  {
+    m_Vertices.clear();
+    m_Indices.clear();
+    m_PolygonCount = 0;
+  }
+
+  // The triangulation of fixed size polygons is specialised for their size
+  template<std::size_t NumberOfSides>
+  void Add(Polygon<T, NumberOfSides> const &polygon)
+  {
+    auto const First = static_cast<GLuint>(m_Vertices.size());
+    m_Vertices.insert(
+      m_Vertices.end(), polygon.m_Corners.begin(), polygon.m_Corners.end());
+    AppendIndices(First, Triangulate(polygon));
+    ++m_PolygonCount;
+  }
+  // Outlines with fewer than three corners draw nothing and are dropped
+  void Add(std::span<Point2<T> const> corners)
+  {
+    if (corners.size() < 3) { return; }
+    auto const First = static_cast<GLuint>(m_Vertices.size());
+    m_Vertices.insert(m_Vertices.end(), corners.begin(), corners.end());
+    m_Scratch.resize(corners.size());
+    auto const Start = m_Indices.size();
+    Triangulate(corners, std::span(m_Scratch), std::back_inserter(m_Indices));
+    for (auto Index = Start; Index < m_Indices.size(); ++Index) {
+      m_Indices[Index] += First;
+    }
+    ++m_PolygonCount;
+  }
+
+  [[nodiscard]] auto GetVertices() const noexcept
+    -> std::span<Point2<T> const>
+  {
+    return m_Vertices;
+  }
+  [[nodiscard]] auto GetIndices() const noexcept -> std::span<GLuint const>
+  {
+    return m_Indices;
+  }
+  [[nodiscard]] auto GetPolygonCount() const noexcept -> std::size_t
+  {
+    return m_PolygonCount;
+  }
+  [[nodiscard]] auto GetTriangleCount() const noexcept -> std::size_t
+  {
+    return m_Indices.size() / 3;
+  }
+};
+
+// Draws a whole PolygonBatch with one glDrawElements call. The caller's
+// program reads the position at location 0 and the colour at location 1.
+// The renderer cannot be moved: drawers made from it keep its address.
+class PolygonRenderer
+{
+  GLuint m_VertexArray{};
+  GLuint m_VertexBuffer{};
+  std::size_t m_VertexCapacity{};
+  GLuint m_IndexBuffer{};
+  std::size_t m_IndexCapacity{};
+  GLsizei m_IndexCount{};
+
+  void UploadBuffers(std::span<std::byte const> vertices,
+    std::span<VertexAttribute const> attributes,
+    GLsizei stride,
+    std::span<GLuint const> indices);
+
+public:
+  PolygonRenderer();
+  PolygonRenderer(PolygonRenderer const &) = delete;
+  PolygonRenderer(PolygonRenderer &&) = delete;
+  auto operator=(PolygonRenderer const &) -> PolygonRenderer & = delete;
+  auto operator=(PolygonRenderer &&) -> PolygonRenderer & = delete;
+  ~PolygonRenderer();
+
+  template<typename T> void Upload(PolygonBatch<T> const &batch)
+  {
+    UploadBuffers(std::as_bytes(batch.GetVertices()),
+      VertexLayout<Point2<T>>::kAttributes,
+      VertexLayout<Point2<T>>::kStride,
+      batch.GetIndices());
+  }
+
+  [[nodiscard]] auto GetVertexArray() const noexcept -> GLuint
+  {
+    return m_VertexArray;
+  }
+  [[nodiscard]] auto GetIndexCount() const noexcept -> GLsizei
+  {
+    return m_IndexCount;
+  }
+
+  // Binds the vertex array and draws every uploaded triangle
+  void Draw() const noexcept;
+  // Drawer that uses program and draws the triangles uploaded at the time
+  // it runs
+  [[nodiscard]] auto MakeDrawer(Program const &program) const -> OpenGLDrawer;
+};
+}// namespace renderer::gl
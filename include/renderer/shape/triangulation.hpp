@@ -0,0 +1,193 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <numeric>
+#include <renderer/point/point.hpp>
+#include <renderer/shape/shape.hpp>
+#include <renderer/vector/vector.hpp>
+#include <span>
+
+// Splits simple polygons into triangles for indexed drawing. Triangles
+// keep the winding of the polygon and index its corners, so corner
+// attributes such as colour carry over unchanged. Convex polygons are
+// fanned from the first corner; the rest go through ear clipping.
+namespace renderer {
+
+namespace _impl {
+  // Twice the signed area of triangle origin, a, b: positive when the
+  // corners turn anticlockwise
+  template<typename T>
+  constexpr auto Turn(Vector<T, 2> const &origin,
+    Vector<T, 2> const &a,
+    Vector<T, 2> const &b) noexcept -> T
+  {
+    auto const [OriginX, OriginY] = origin.m_Values;
+    return (a.m_Values[0] - OriginX) * (b.m_Values[1] - OriginY)
+           - (a.m_Values[1] - OriginY) * (b.m_Values[0] - OriginX);
+  }
+
+  template<typename T>
+  constexpr auto Position(std::span<Point2<T> const> corners,
+    std::uint32_t index) noexcept -> Vector<T, 2> const &
+  {
+    return corners[index].m_PositionVector;
+  }
+
+  // Whether corner current of the remaining outline can be cut off: it
+  // turns the same way as the polygon and no other remaining corner lies
+  // inside or on the triangle it forms with its neighbours
+  template<typename T>
+  constexpr auto IsEar(std::span<Point2<T> const> corners,
+    std::span<std::uint32_t const> remaining,
+    std::size_t current,
+    T orientation) noexcept -> bool
+  {
+    auto const Count = remaining.size();
+    auto const Previous = remaining[(current + Count - 1) % Count];
+    auto const Next = remaining[(current + 1) % Count];
+    auto const &A = Position(corners, Previous);
+    auto const &B = Position(corners, remaining[current]);
+    auto const &C = Position(corners, Next);
+    if (!(Turn(A, B, C) * orientation > T{})) { return false; }
+    for (auto const Other : remaining) {
+      if (Other == Previous || Other == remaining[current] || Other == Next) {
+        continue;
+      }
+      auto const &P = Position(corners, Other);
+      if (Turn(A, B, P) * orientation >= T{}
+          && Turn(B, C, P) * orientation >= T{}
+          && Turn(C, A, P) * orientation >= T{}) {
+        return false;
+      }
+    }
+    return true;
+  }
+}// namespace _impl
+
+// Twice the signed area, positive for anticlockwise corners
+template<typename T>
+constexpr auto DoubleSignedArea(std::span<Point2<T> const> corners) noexcept
+  -> T
+{
+  T Area{};
+  for (std::size_t Index = 0; Index < corners.size(); ++Index) {
+    auto const &[X0, Y0] = corners[Index].m_PositionVector.m_Values;
+    auto const &[X1, Y1] =
+      corners[(Index + 1) % corners.size()].m_PositionVector.m_Values;
+    Area += X0 * Y1 - X1 * Y0;
+  }
+  return Area;
+}
+
+// Whether every corner turns the same way, allowing straight corners
+template<typename T>
+constexpr auto IsConvex(std::span<Point2<T> const> corners) noexcept -> bool
+{
+  auto const Orientation = DoubleSignedArea(corners) < T{} ? T{ -1 } : T{ 1 };
+  auto const Count = corners.size();
+  for (std::size_t Index = 0; Index < Count; ++Index) {
+    if (_impl::Turn(corners[(Index + Count - 1) % Count].m_PositionVector,
+          corners[Index].m_PositionVector,
+          corners[(Index + 1) % Count].m_PositionVector)
+          * Orientation
+        < T{}) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Indices fanning a convex polygon with Corners corners from corner 0
+template<std::size_t Corners>
+  requires(Corners > 2)
+consteval auto MakeFanIndices()
+  -> std::array<std::uint32_t, 3 * (Corners - 2)>
+{
+  std::array<std::uint32_t, 3 * (Corners - 2)> Indices{};
+  for (std::uint32_t Edge = 1; Edge + 1 < Corners; ++Edge) {
+    Indices[3 * Edge - 3] = 0;
+    Indices[3 * Edge - 2] = Edge;
+    Indices[3 * Edge - 1] = Edge + 1;
+  }
+  return Indices;
+}
+template<std::size_t Corners>
+  requires(Corners > 2)
+inline constexpr auto kFanIndices = MakeFanIndices<Corners>();
+
+// Writes 3 * (corners.size() - 2) indices into corners to output and
+// returns the end of them; fewer than three corners write nothing.
+// scratch must hold at least corners.size() elements. Input that is not a
+// simple polygon still gives that many triangles, but they may overlap or
+// leave the outline.
+template<typename T, std::output_iterator<std::uint32_t> Output>
+constexpr auto Triangulate(std::span<Point2<T> const> corners,
+  std::span<std::uint32_t> scratch,
+  Output output) -> Output
+{
+  auto Count = corners.size();
+  if (Count < 3) { return output; }
+  auto Emit = [&](std::uint32_t a, std::uint32_t b, std::uint32_t c) {
+    *output++ = a;
+    *output++ = b;
+    *output++ = c;
+  };
+  if (IsConvex(corners)) {
+    for (std::uint32_t Index = 1; Index + 1 < Count; ++Index) {
+      Emit(0, Index, Index + 1);
+    }
+    return output;
+  }
+
+  auto const Orientation = DoubleSignedArea(corners) < T{} ? T{ -1 } : T{ 1 };
+  auto Remaining = scratch.first(Count);
+  std::iota(Remaining.begin(), Remaining.end(), std::uint32_t{ 0 });
+  std::size_t Current = 0;
+  // Corners examined since the last ear; a whole lap without one only
+  // happens for degenerate outlines, which are cut regardless
+  std::size_t Examined = 0;
+  while (Count > 3) {
+    if (Examined < Count
+        && !_impl::IsEar(corners,
+          std::span<std::uint32_t const>(Remaining.first(Count)),
+          Current,
+          Orientation)) {
+      Current = (Current + 1) % Count;
+      ++Examined;
+      continue;
+    }
+    Emit(Remaining[(Current + Count - 1) % Count],
+      Remaining[Current],
+      Remaining[(Current + 1) % Count]);
+    std::shift_left(Remaining.begin() + static_cast<std::ptrdiff_t>(Current),
+      Remaining.begin() + static_cast<std::ptrdiff_t>(Count),
+      1);
+    --Count;
+    Current %= Count;
+    Examined = 0;
+  }
+  Emit(Remaining[0], Remaining[1], Remaining[2]);
+  return output;
+}
+
+// Fixed size polygons need no scratch allocation, and triangles skip the
+// convexity test altogether
+template<typename T, std::size_t NumberOfSides>
+constexpr auto Triangulate(Polygon<T, NumberOfSides> const &polygon)
+  -> std::array<std::uint32_t, 3 * (NumberOfSides - 2)>
+{
+  if constexpr (NumberOfSides == 3) {
+    return kFanIndices<3>;
+  } else {
+    std::array<std::uint32_t, NumberOfSides> Scratch{};
+    std::array<std::uint32_t, 3 * (NumberOfSides - 2)> Indices{};
+    Triangulate(std::span<Point2<T> const>(polygon.m_Corners),
+      std::span(Scratch),
+      Indices.begin());
+    return Indices;
+  }
+}
+}// namespace renderer
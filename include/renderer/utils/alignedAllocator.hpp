@@ -0,0 +1,43 @@
+#pragma once
+#include <cstddef>
+#include <new>
+
+namespace renderer {
+// Allocator for containers whose storage must start on an Alignment byte
+// boundary, such as cache line aligned arrays that are read with SIMD loads
+template<typename T, std::size_t Alignment> struct AlignedAllocator
+{
+  static_assert(Alignment >= alignof(T) && (Alignment & (Alignment - 1)) == 0,
+    "Alignment must be a power of two no smaller than alignof(T)");
+  using value_type = T;
+  template<typename U> struct rebind
+  {
+    using other = AlignedAllocator<U, Alignment>;
+  };
+
+  AlignedAllocator() = default;
+  template<typename U>
+  // NOLINTNEXTLINE(hicpp-explicit-conversions)
+  constexpr AlignedAllocator(
+    AlignedAllocator<U, Alignment> const & /*other*/) noexcept
+  {}
+
+  [[nodiscard]] auto allocate(std::size_t count) -> T *
+  {
+    return static_cast<T *>(
+      ::operator new(count * sizeof(T), std::align_val_t{ Alignment }));
+  }
+  void deallocate(T *pointer, std::size_t count) noexcept
+  {
+    ::operator delete(
+      pointer, count * sizeof(T), std::align_val_t{ Alignment });
+  }
+
+  template<typename U>
+  constexpr auto operator==(
+    AlignedAllocator<U, Alignment> const & /*other*/) const noexcept -> bool
+  {
+    return true;
+  }
+};
+}// namespace renderer
@@ -0,0 +1,104 @@
+#pragma once
+#include <bit>
+#include <cstdint>
+#include <limits>
+
+// exp, log and pow usable in constant expressions, for tables generated at
+// compile time. Accurate to a few units in the last place of a double,
+// which is far below anything a float or 8 bit table keeps.
+namespace renderer::math {
+
+namespace _impl {
+  // ln 2 split so that k * kLn2High is exact for the k used here
+  constexpr double kLn2High = 6.93147180369123816490e-01;
+  constexpr double kLn2Low = 1.90821492927058770002e-10;
+  constexpr double kLn2 = 0.69314718055994530942;
+
+  // 2^exponent for exponents that give normal or subnormal doubles
+  constexpr auto PowerOfTwo(int exponent) noexcept -> double
+  {
+    constexpr int kBias = 1023;
+    constexpr int kMantissaBits = 52;
+    if (exponent >= -kBias + 1) {
+      return std::bit_cast<double>(static_cast<std::uint64_t>(exponent + kBias)
+                                   << kMantissaBits);
+    }
+    return PowerOfTwo(-kBias + 1) * PowerOfTwo(exponent + kBias - 1);
+  }
+}// namespace _impl
+
+constexpr auto Exp(double value) noexcept -> double
+{
+  constexpr double kOverflow = 709.782712893384;
+  constexpr double kUnderflow = -745.1332191019412;
+  if (value != value) { return value; }
+  if (value > kOverflow) { return std::numeric_limits<double>::infinity(); }
+  if (value < kUnderflow) { return 0.0; }
+  // value = k ln 2 + r with |r| <= ln 2 / 2, then a Taylor series for e^r
+  auto const Scaled = value / _impl::kLn2;
+  auto const K = static_cast<int>(Scaled < 0 ? Scaled - 0.5 : Scaled + 0.5);
+  auto const R = (value - K * _impl::kLn2High) - K * _impl::kLn2Low;
+  double Sum = 1.0;
+  double Term = 1.0;
+  for (int Order = 1; Order < 30 && Term != 0.0; ++Order) {
+    Term *= R / Order;
+    Sum += Term;
+  }
+  // Split the scaling at both ends so only the final product rounds
+  constexpr int kSplit = 60;
+  if (K > std::numeric_limits<double>::max_exponent - 1) {
+    return Sum * 2.0 * _impl::PowerOfTwo(K - 1);
+  }
+  if (K < std::numeric_limits<double>::min_exponent - 1) {
+    return Sum * _impl::PowerOfTwo(K + kSplit) * _impl::PowerOfTwo(-kSplit);
+  }
+  return Sum * _impl::PowerOfTwo(K);
+}
+
+constexpr auto Log(double value) noexcept -> double
+{
+  if (value != value || value < 0.0) {
+    return std::numeric_limits<double>::quiet_NaN();
+  }
+  if (value == 0.0) { return -std::numeric_limits<double>::infinity(); }
+  if (value == std::numeric_limits<double>::infinity()) { return value; }
+  // value = m 2^e with m in [sqrt(1/2), sqrt(2)), then
+  // log m = 2 atanh((m - 1) / (m + 1))
+  int Exponent = 0;
+  if (value < std::numeric_limits<double>::min()) {
+    constexpr int kSubnormalShift = 64;
+    value *= _impl::PowerOfTwo(kSubnormalShift);
+    Exponent -= kSubnormalShift;
+  }
+  auto const Bits = std::bit_cast<std::uint64_t>(value);
+  Exponent += static_cast<int>((Bits >> 52U) & 0x7FFU) - 1023;
+  auto Mantissa = std::bit_cast<double>(
+    (Bits & 0x000F'FFFF'FFFF'FFFFULL) | 0x3FF0'0000'0000'0000ULL);
+  constexpr double kSqrt2 = 1.41421356237309504880;
+  if (Mantissa > kSqrt2) {
+    Mantissa /= 2.0;
+    ++Exponent;
+  }
+  auto const S = (Mantissa - 1.0) / (Mantissa + 1.0);
+  auto const S2 = S * S;
+  double Sum = 0.0;
+  double Power = S;
+  for (int Odd = 1; Odd < 60; Odd += 2) {
+    auto const Term = Power / Odd;
+    if (Sum + Term == Sum) { break; }
+    Sum += Term;
+    Power *= S2;
+  }
+  return Exponent * _impl::kLn2High + (Exponent * _impl::kLn2Low + 2.0 * Sum);
+}
+
+// base^exponent for base >= 0, which is all the colour curves need
+constexpr auto Pow(double base, double exponent) noexcept -> double
+{
+  if (exponent == 0.0) { return 1.0; }
+  if (base == 0.0) {
+    return exponent > 0.0 ? 0.0 : std::numeric_limits<double>::infinity();
+  }
+  return Exp(exponent * Log(base));
+}
+}// namespace renderer::math
@@ -0,0 +1,48 @@
+#pragma once
+#include <chrono>
+#include <filesystem>
+#include <mutex>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace renderer::utils {
+
+struct ChangedFile
+{
+  std::filesystem::path Path;
+  std::string Contents;
+};
+
+// Watches the files directly inside a directory from a background thread,
+// using inotify where available and modification times elsewhere. Changed
+// files are read on that thread too, so TakeChanges never touches the
+// filesystem and is safe to call once per frame.
+class FileWatcher
+{
+  std::filesystem::path m_Directory;
+  std::chrono::milliseconds m_PollInterval;
+  std::mutex m_Mutex;
+  std::vector<ChangedFile> m_Changes{};
+  // Declared last so the thread is joined before the state it uses goes away
+  std::jthread m_Thread;
+
+  void Run(std::stop_token const &stop_token);
+  auto RunNotified(std::stop_token const &stop_token) -> bool;
+  void RunPolling(std::stop_token const &stop_token);
+  void Publish(std::filesystem::path const &path);
+
+public:
+  explicit FileWatcher(std::filesystem::path directory,
+    std::chrono::milliseconds poll_interval = std::chrono::milliseconds(100));
+  FileWatcher(FileWatcher const &) = delete;
+  FileWatcher(FileWatcher &&) = delete;
+  auto operator=(FileWatcher const &) -> FileWatcher & = delete;
+  auto operator=(FileWatcher &&) -> FileWatcher & = delete;
+  ~FileWatcher() = default;
+
+  // Files written since the last call, each with its newest contents
+  [[nodiscard]] auto TakeChanges() -> std::vector<ChangedFile>;
+};
+}// namespace renderer::utils
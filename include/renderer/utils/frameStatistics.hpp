@@ -0,0 +1,37 @@
+#pragma once
+#include <cstddef>
+
+namespace renderer {
+// Per-frame counters gathered from the drawing abstractions, used to see how
+// much GL state traffic a frame generated and how much of it was avoided.
+struct FrameStatistics
+{
+  std::size_t DrawerCalls{};
+  std::size_t ProgramBinds{};
+  std::size_t VertexArrayBinds{};
+  std::size_t TextureBinds{};
+  std::size_t BlendChanges{};
+  std::size_t RedundantBindsSkipped{};
+  std::size_t UniformUploads{};
+  std::size_t UniformUploadsElided{};
+  // Times a streaming buffer waited for the GPU to release a region
+  std::size_t StreamingStalls{};
+
+  constexpr auto operator+=(FrameStatistics const &other) noexcept
+    -> FrameStatistics &
+  {
+    DrawerCalls += other.DrawerCalls;
+    ProgramBinds += other.ProgramBinds;
+    VertexArrayBinds += other.VertexArrayBinds;
+    TextureBinds += other.TextureBinds;
+    BlendChanges += other.BlendChanges;
+    RedundantBindsSkipped += other.RedundantBindsSkipped;
+    UniformUploads += other.UniformUploads;
+    UniformUploadsElided += other.UniformUploadsElided;
+    StreamingStalls += other.StreamingStalls;
+    return *this;
+  }
+  friend constexpr auto operator==(FrameStatistics const &,
+    FrameStatistics const &) -> bool = default;
+};
+}// namespace renderer
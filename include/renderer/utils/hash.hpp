@@ -0,0 +1,34 @@
+#pragma once
+#include <cstdint>
+#include <string_view>
+
+namespace renderer::utils {
+
+inline constexpr std::uint64_t kFnv1aOffsetBasis = 0xcbf29ce484222325ULL;
+inline constexpr std::uint64_t kFnv1aPrime = 0x100000001b3ULL;
+
+// 64-bit FNV-1a, continuing from seed so several strings can be chained
+constexpr auto Fnv1a(std::string_view data,
+  std::uint64_t seed = kFnv1aOffsetBasis) noexcept -> std::uint64_t
+{
+  auto Hash = seed;
+  for (char const Character : data) {
+    Hash ^= static_cast<std::uint8_t>(Character);
+    Hash *= kFnv1aPrime;
+  }
+  return Hash;
+}
+
+// Hashes value's little-endian bytes, used to separate chained strings by
+// their lengths so that {"ab", "c"} and {"a", "bc"} differ
+constexpr auto Fnv1a(std::uint64_t value, std::uint64_t seed) noexcept
+  -> std::uint64_t
+{
+  auto Hash = seed;
+  for (int Byte = 0; Byte < 8; ++Byte) {
+    Hash ^= (value >> (Byte * 8)) & 0xFFU;
+    Hash *= kFnv1aPrime;
+  }
+  return Hash;
+}
+}// namespace renderer::utils
@@ -0,0 +1,132 @@
+#pragma once
+#include <array>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace renderer::utils {
+
+inline constexpr std::size_t kDefaultInlineFunctionCapacity =
+  4 * sizeof(void *);
+
+template<typename Signature,
+  std::size_t Capacity = kDefaultInlineFunctionCapacity>
+class InlineFunction;
+
+namespace _impl {
+  // Small trivially copyable arguments are handed to the invoker by value,
+  // everything else by reference, so calling through the type erasure never
+  // copies an argument the caller did not already copy.
+  template<typename T> consteval auto PassByValue() -> bool
+  {
+    if constexpr (std::is_reference_v<T>) {
+      return false;
+    } else {
+      return std::is_trivially_copyable_v<T> && sizeof(T) <= 2 * sizeof(void *);
+    }
+  }
+  template<typename T>
+  using ForwardedParam = std::conditional_t<PassByValue<T>(), T, T &&>;
+}// namespace _impl
+
+// Move-only callable wrapper that stores its target in a fixed, in-object
+// buffer of Capacity bytes. Unlike std::function it never allocates; a target
+// that does not fit is a compile error.
+template<typename Ret, typename... Params, std::size_t Capacity>
+class [[nodiscard]] InlineFunction<Ret(Params...), Capacity>
+{
+  using Invoker = Ret (*)(void *, _impl::ForwardedParam<Params>...);
+  // Move constructs the target at destination from source and destroys the
+  // source. With a null destination only the source is destroyed. A null
+  // manager means the target is trivially relocatable.
+  using Manager = void (*)(void *destination, void *source) noexcept;
+
+  alignas(std::max_align_t) std::array<std::byte, Capacity> m_Storage{};
+  Invoker m_Invoke{};
+  Manager m_Manage{};
+
+  template<typename Func>
+  static auto Invoke(void *storage, _impl::ForwardedParam<Params>... args)
+    -> Ret
+  {
+    return std::invoke_r<Ret>(*std::launder(static_cast<Func *>(storage)),
+      std::forward<Params>(args)...);
+  }
+  template<typename Func>
+  static void Manage(void *destination, void *source) noexcept
+  {
+    auto *Source = std::launder(static_cast<Func *>(source));
+    if (destination != nullptr) {
+      ::new (destination) Func(std::move(*Source));
+    }
+    std::destroy_at(Source);
+  }
+  void Reset() noexcept
+  {
+    if (m_Manage != nullptr) { m_Manage(nullptr, m_Storage.data()); }
+    m_Invoke = nullptr;
+    m_Manage = nullptr;
+  }
+  void TakeFrom(InlineFunction &other) noexcept
+  {
+    if (other.m_Manage != nullptr) {
+      other.m_Manage(m_Storage.data(), other.m_Storage.data());
+    } else {
+      std::memcpy(m_Storage.data(), other.m_Storage.data(), Capacity);
+    }
+    m_Invoke = std::exchange(other.m_Invoke, nullptr);
+    m_Manage = std::exchange(other.m_Manage, nullptr);
+  }
+
+public:
+  static constexpr std::size_t kCapacity = Capacity;
+
+  InlineFunction() = default;
+  template<typename Func>
+    requires(!std::same_as<std::remove_cvref_t<Func>, InlineFunction>
+             && std::is_invocable_r_v<Ret, std::decay_t<Func> &, Params...>)
+  explicit InlineFunction(Func &&function)
+  {
+    using Stored = std::decay_t<Func>;
+    static_assert(sizeof(Stored) <= Capacity,
+      "Callable is too large for this InlineFunction; raise its Capacity");
+    static_assert(alignof(Stored) <= alignof(std::max_align_t),
+      "Callable is over-aligned for InlineFunction storage");
+    static_assert(std::is_nothrow_move_constructible_v<Stored>,
+      "InlineFunction requires a nothrow move constructible callable");
+    ::new (m_Storage.data()) Stored(std::forward<Func>(function));
+    m_Invoke = &Invoke<Stored>;
+    if constexpr (!std::is_trivially_copyable_v<Stored>) {
+      m_Manage = &Manage<Stored>;
+    }
+  }
+  InlineFunction(InlineFunction const &) = delete;
+  InlineFunction(InlineFunction &&other) noexcept { TakeFrom(other); }
+  auto operator=(InlineFunction const &) -> InlineFunction & = delete;
+  auto operator=(InlineFunction &&other) noexcept -> InlineFunction &
+  {
+    if (this != &other) {
+      Reset();
+      TakeFrom(other);
+    }
+    return *this;
+  }
+  ~InlineFunction() { Reset(); }
+
+  [[nodiscard]] explicit operator bool() const noexcept
+  {
+    return m_Invoke != nullptr;
+  }
+  auto operator()(Params... args) -> Ret
+  {
+    assert(m_Invoke != nullptr && "Called an empty InlineFunction");
+    return m_Invoke(m_Storage.data(), std::forward<Params>(args)...);
+  }
+};
+}// namespace renderer::utils
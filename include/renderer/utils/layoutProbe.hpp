@@ -0,0 +1,29 @@
+#pragma once
+#include <array>
+#include <cstddef>
+
+// Probe objects for checking at compile time that a list of member pointers
+// matches the real layout of a struct: a probe is std::bit_cast from bytes
+// that each hold their own index, so reading a member back shows which
+// bytes it occupies.
+namespace renderer::utils {
+
+// Byte index of a probe. Kept between 1 and 63 so every float or double
+// read from a probe is a normal number, which survives std::bit_cast
+// unchanged.
+constexpr auto ProbeByte(std::size_t index) noexcept -> std::byte
+{
+  constexpr std::size_t kPeriod = 63;
+  return static_cast<std::byte>(index % kPeriod + 1);
+}
+
+template<typename T>
+consteval auto MakeProbeBytes() -> std::array<std::byte, sizeof(T)>
+{
+  std::array<std::byte, sizeof(T)> Bytes{};
+  for (std::size_t Index = 0; Index < Bytes.size(); ++Index) {
+    Bytes[Index] = ProbeByte(Index);
+  }
+  return Bytes;
+}
+}// namespace renderer::utils
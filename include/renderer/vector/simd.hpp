@@ -0,0 +1,37 @@
+#pragma once
+#include <cstddef>
+#if __has_include(<experimental/simd>)
+#include <experimental/simd>
+#endif
+
+// Thin portable layer over the Parallelism TS simd types, used by the
+// Vector arithmetic in vectorExpression.hpp. RENDERER_HAS_SIMD is only
+// defined when the standard library provides them; otherwise, or when
+// RENDERER_NO_SIMD is defined, callers use plain loops instead.
+#if defined(__cpp_lib_experimental_parallel_simd) && !defined(RENDERER_NO_SIMD)
+#define RENDERER_HAS_SIMD 1
+
+namespace renderer::simd {
+
+// Native registers for T where N fits them, several otherwise
+template<typename T, std::size_t N>
+using Pack = std::experimental::simd<T,
+  std::experimental::simd_abi::deduce_t<T, static_cast<int>(N)>>;
+
+template<std::size_t N, typename T>
+[[nodiscard]] inline auto Load(T const *data) noexcept -> Pack<T, N>
+{
+  return Pack<T, N>(data, std::experimental::element_aligned);
+}
+
+template<typename T, typename P> inline void Store(P const &pack, T *data)
+{
+  pack.copy_to(data, std::experimental::element_aligned);
+}
+
+template<typename P> [[nodiscard]] inline auto Sum(P const &pack)
+{
+  return std::experimental::reduce(pack);
+}
+}// namespace renderer::simd
+#endif
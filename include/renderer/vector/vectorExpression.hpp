@@ -0,0 +1,399 @@
+#pragma once
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <renderer/vector/simd.hpp>
+#include <renderer/vector/vector.hpp>
+#include <type_traits>
+#include <utility>
+
+// Element-wise arithmetic and geometry for renderer::Vector. The operators
+// build expression templates instead of vectors, so A * S + B - C is
+// evaluated in one pass, without temporaries, when it is converted to a
+// Vector or passed to Evaluate. Outside constant evaluation float and
+// double expressions are evaluated a whole vector at a time with SIMD.
+//
+// Expressions hold their named Vector operands by reference, like a view:
+// keep them alive while an `auto` expression is still to be evaluated.
+namespace renderer {
+
+namespace _impl {
+  template<typename T> struct ExpressionTraits
+  {};
+  template<typename T, std::size_t Dimension>
+  struct ExpressionTraits<renderer::Vector<T, Dimension>>
+  {
+    using Value = T;
+    static constexpr std::size_t kDimension = Dimension;
+    static constexpr bool kIsVector = true;
+  };
+  template<typename T>
+    requires(T::kIsVectorExpression)
+  struct ExpressionTraits<T>
+  {
+    using Value = typename T::Value;
+    static constexpr std::size_t kDimension = T::kDimension;
+    static constexpr bool kIsVector = false;
+  };
+}// namespace _impl
+
+template<typename E>
+using ValueOf = typename _impl::ExpressionTraits<std::remove_cvref_t<E>>::Value;
+template<typename E>
+inline constexpr std::size_t kDimensionOf =
+  _impl::ExpressionTraits<std::remove_cvref_t<E>>::kDimension;
+
+// A Vector of numbers, or an unevaluated expression over them
+template<typename E>
+concept vector_expression = requires {
+  typename _impl::ExpressionTraits<std::remove_cvref_t<E>>::Value;
+} && std::is_arithmetic_v<ValueOf<E>>;
+
+template<typename L, typename R>
+concept compatible_vectors =
+  vector_expression<L> && vector_expression<R>
+  && std::same_as<ValueOf<L>, ValueOf<R>> && kDimensionOf<L> == kDimensionOf<R>;
+
+namespace _impl {
+#if defined(RENDERER_HAS_SIMD)
+  template<typename T>
+  inline constexpr bool kUsesSimd =
+    std::same_as<T, float> || std::same_as<T, double>;
+#else
+  template<typename T> inline constexpr bool kUsesSimd = false;
+#endif
+
+  template<typename E>
+  inline constexpr bool kIsVector =
+    ExpressionTraits<std::remove_cvref_t<E>>::kIsVector;
+
+  // Named vectors are held by reference; temporaries and expressions, which
+  // are small, by value
+  template<typename E>
+  using Stored =
+    std::conditional_t<kIsVector<E> && std::is_lvalue_reference_v<E>,
+      std::remove_cvref_t<E> const &,
+      std::remove_cvref_t<E>>;
+
+  template<typename E>
+  constexpr auto Element(E const &expression, std::size_t index) -> ValueOf<E>
+  {
+    if constexpr (kIsVector<E>) {
+      return expression.m_Values[index];
+    } else {
+      return expression[index];
+    }
+  }
+
+#if defined(RENDERER_HAS_SIMD)
+  template<typename E> inline auto LoadPack(E const &expression)
+  {
+    if constexpr (kIsVector<E>) {
+      return simd::Load<kDimensionOf<E>>(expression.m_Values.data());
+    } else {
+      return expression.Pack();
+    }
+  }
+#endif
+}// namespace _impl
+
+template<vector_expression E>
+constexpr auto Evaluate(E const &expression)
+  -> Vector<ValueOf<E>, kDimensionOf<E>>
+{
+  Vector<ValueOf<E>, kDimensionOf<E>> Result{};
+#if defined(RENDERER_HAS_SIMD)
+  if !consteval {
+    if constexpr (_impl::kUsesSimd<ValueOf<E>>) {
+      simd::Store(_impl::LoadPack(expression), Result.m_Values.data());
+      return Result;
+    }
+  }
+#endif
+  for (std::size_t Index = 0; Index < kDimensionOf<E>; ++Index) {
+    Result.m_Values[Index] = _impl::Element(expression, Index);
+  }
+  return Result;
+}
+
+namespace _impl {
+  template<typename Operation, typename Left, typename Right>
+  class BinaryExpression
+  {
+    Stored<Left> m_Left;
+    Stored<Right> m_Right;
+
+  public:
+    static constexpr bool kIsVectorExpression = true;
+    using Value = ValueOf<Left>;
+    static constexpr std::size_t kDimension = kDimensionOf<Left>;
+
+    constexpr BinaryExpression(Left &&left, Right &&right)
+      : m_Left(std::forward<Left>(left)), m_Right(std::forward<Right>(right))
+    {}
+
+    constexpr auto operator[](std::size_t index) const -> Value
+    {
+      return Operation{}(Element(m_Left, index), Element(m_Right, index));
+    }
+#if defined(RENDERER_HAS_SIMD)
+    auto Pack() const
+    {
+      return Operation{}(LoadPack(m_Left), LoadPack(m_Right));
+    }
+#endif
+    // NOLINTNEXTLINE(hicpp-explicit-conversions)
+    constexpr operator Vector<Value, kDimension>() const
+    {
+      return Evaluate(*this);
+    }
+  };
+
+  template<typename Operation, typename Operand> class UnaryExpression
+  {
+    Stored<Operand> m_Operand;
+
+  public:
+    static constexpr bool kIsVectorExpression = true;
+    using Value = ValueOf<Operand>;
+    static constexpr std::size_t kDimension = kDimensionOf<Operand>;
+
+    constexpr explicit UnaryExpression(Operand &&operand)
+      : m_Operand(std::forward<Operand>(operand))
+    {}
+
+    constexpr auto operator[](std::size_t index) const -> Value
+    {
+      return Operation{}(Element(m_Operand, index));
+    }
+#if defined(RENDERER_HAS_SIMD)
+    auto Pack() const { return Operation{}(LoadPack(m_Operand)); }
+#endif
+    // NOLINTNEXTLINE(hicpp-explicit-conversions)
+    constexpr operator Vector<Value, kDimension>() const
+    {
+      return Evaluate(*this);
+    }
+  };
+
+  // A scalar repeated across every element
+  template<typename T, std::size_t Dimension> class ScalarExpression
+  {
+    T m_Value;
+
+  public:
+    static constexpr bool kIsVectorExpression = true;
+    using Value = T;
+    static constexpr std::size_t kDimension = Dimension;
+
+    constexpr explicit ScalarExpression(T value) : m_Value(value) {}
+
+    constexpr auto operator[](std::size_t /*index*/) const -> Value
+    {
+      return m_Value;
+    }
+#if defined(RENDERER_HAS_SIMD)
+    auto Pack() const { return simd::Pack<T, Dimension>(m_Value); }
+#endif
+  };
+
+  template<typename E, typename S>
+  constexpr auto Broadcast(S scalar)
+    -> ScalarExpression<ValueOf<E>, kDimensionOf<E>>
+  {
+    return ScalarExpression<ValueOf<E>, kDimensionOf<E>>(
+      static_cast<ValueOf<E>>(scalar));
+  }
+
+  template<std::floating_point T> constexpr auto Sqrt(T value) noexcept -> T
+  {
+    if consteval {
+      if (value != value) { return value; }
+      if (value < 0) { return std::numeric_limits<T>::quiet_NaN(); }
+      if (value == 0 || value == std::numeric_limits<T>::infinity()) {
+        return value;
+      }
+      // Newton's method falls monotonically from above to the root
+      T Estimate = value > 1 ? value : T{ 1 };
+      while (true) {
+        T const Next = (Estimate + value / Estimate) / 2;
+        if (Next >= Estimate) { return Estimate; }
+        Estimate = Next;
+      }
+    }
+    return std::sqrt(value);
+  }
+}// namespace _impl
+
+template<typename L, typename R>
+  requires compatible_vectors<L, R>
+constexpr auto operator+(L &&left, R &&right)
+{
+  return _impl::BinaryExpression<std::plus<>, L, R>(
+    std::forward<L>(left), std::forward<R>(right));
+}
+template<typename L, typename R>
+  requires compatible_vectors<L, R>
+constexpr auto operator-(L &&left, R &&right)
+{
+  return _impl::BinaryExpression<std::minus<>, L, R>(
+    std::forward<L>(left), std::forward<R>(right));
+}
+// Element-wise, like GLSL; see Dot for the inner product
+template<typename L, typename R>
+  requires compatible_vectors<L, R>
+constexpr auto operator*(L &&left, R &&right)
+{
+  return _impl::BinaryExpression<std::multiplies<>, L, R>(
+    std::forward<L>(left), std::forward<R>(right));
+}
+template<typename L, typename R>
+  requires compatible_vectors<L, R>
+constexpr auto operator/(L &&left, R &&right)
+{
+  return _impl::BinaryExpression<std::divides<>, L, R>(
+    std::forward<L>(left), std::forward<R>(right));
+}
+template<vector_expression E> constexpr auto operator-(E &&operand)
+{
+  return _impl::UnaryExpression<std::negate<>, E>(std::forward<E>(operand));
+}
+
+template<vector_expression E, typename S>
+  requires std::is_arithmetic_v<S>
+constexpr auto operator*(E &&vector, S scalar)
+{
+  return std::forward<E>(vector) * _impl::Broadcast<E>(scalar);
+}
+template<vector_expression E, typename S>
+  requires std::is_arithmetic_v<S>
+constexpr auto operator*(S scalar, E &&vector)
+{
+  return _impl::Broadcast<E>(scalar) * std::forward<E>(vector);
+}
+template<vector_expression E, typename S>
+  requires std::is_arithmetic_v<S>
+constexpr auto operator/(E &&vector, S scalar)
+{
+  return std::forward<E>(vector) / _impl::Broadcast<E>(scalar);
+}
+
+// The right hand side is evaluated before the vector is written, so it may
+// refer to the vector itself
+template<typename T, std::size_t Dimension, typename E>
+  requires compatible_vectors<Vector<T, Dimension>, E>
+constexpr auto operator+=(Vector<T, Dimension> &vector, E &&other)
+  -> Vector<T, Dimension> &
+{
+  vector = Evaluate(vector + std::forward<E>(other));
+  return vector;
+}
+template<typename T, std::size_t Dimension, typename E>
+  requires compatible_vectors<Vector<T, Dimension>, E>
+constexpr auto operator-=(Vector<T, Dimension> &vector, E &&other)
+  -> Vector<T, Dimension> &
+{
+  vector = Evaluate(vector - std::forward<E>(other));
+  return vector;
+}
+template<typename T, std::size_t Dimension, typename S>
+  requires std::is_arithmetic_v<S> && std::is_arithmetic_v<T>
+constexpr auto operator*=(Vector<T, Dimension> &vector, S scalar)
+  -> Vector<T, Dimension> &
+{
+  vector = Evaluate(vector * scalar);
+  return vector;
+}
+template<typename T, std::size_t Dimension, typename S>
+  requires std::is_arithmetic_v<S> && std::is_arithmetic_v<T>
+constexpr auto operator/=(Vector<T, Dimension> &vector, S scalar)
+  -> Vector<T, Dimension> &
+{
+  vector = Evaluate(vector / scalar);
+  return vector;
+}
+
+template<typename L, typename R>
+  requires compatible_vectors<L, R>
+constexpr auto Dot(L const &left, R const &right) -> ValueOf<L>
+{
+#if defined(RENDERER_HAS_SIMD)
+  if !consteval {
+    if constexpr (_impl::kUsesSimd<ValueOf<L>>) {
+      return simd::Sum(_impl::LoadPack(left) * _impl::LoadPack(right));
+    }
+  }
+#endif
+  ValueOf<L> Sum{};
+  for (std::size_t Index = 0; Index < kDimensionOf<L>; ++Index) {
+    Sum += _impl::Element(left, Index) * _impl::Element(right, Index);
+  }
+  return Sum;
+}
+
+template<vector_expression E>
+constexpr auto LengthSquared(E const &vector) -> ValueOf<E>
+{
+  return Dot(vector, vector);
+}
+
+template<vector_expression E>
+  requires std::floating_point<ValueOf<E>>
+constexpr auto Length(E const &vector) -> ValueOf<E>
+{
+  return _impl::Sqrt(LengthSquared(vector));
+}
+
+// Unit vector along vector; a zero vector gives NaNs, as in GLSL
+template<vector_expression E>
+  requires std::floating_point<ValueOf<E>>
+constexpr auto Normalise(E const &vector)
+  -> Vector<ValueOf<E>, kDimensionOf<E>>
+{
+  auto const Evaluated = Evaluate(vector);
+  return Evaluate(Evaluated / Length(Evaluated));
+}
+
+template<typename L, typename R>
+  requires compatible_vectors<L, R> && (kDimensionOf<L> == 3)
+constexpr auto Cross(L const &left, R const &right) -> Vector<ValueOf<L>, 3>
+{
+  auto const [Ax, Ay, Az] = Evaluate(left).m_Values;
+  auto const [Bx, By, Bz] = Evaluate(right).m_Values;
+  return { { Ay * Bz - Az * By, Az * Bx - Ax * Bz, Ax * By - Ay * Bx } };
+}
+
+// Mirrors incident about the plane with unit normal normal
+template<typename I, typename N>
+  requires compatible_vectors<I, N> && std::floating_point<ValueOf<I>>
+constexpr auto Reflect(I &&incident, N &&normal)
+{
+  auto const Scale = 2 * Dot(normal, incident);
+  return std::forward<I>(incident) - std::forward<N>(normal) * Scale;
+}
+
+// Bends the unit incident direction through a surface with unit normal
+// normal (facing against incident), where eta is the ratio of refractive
+// indices n1 / n2. Empty on total internal reflection.
+template<typename I, typename N>
+  requires compatible_vectors<I, N> && std::floating_point<ValueOf<I>>
+constexpr auto Refract(I const &incident, N const &normal, ValueOf<I> eta)
+  -> std::optional<Vector<ValueOf<I>, kDimensionOf<I>>>
+{
+  auto const Cosine = Dot(normal, incident);
+  auto const K = 1 - eta * eta * (1 - Cosine * Cosine);
+  if (K < 0) { return std::nullopt; }
+  return Evaluate(eta * incident - (eta * Cosine + _impl::Sqrt(K)) * normal);
+}
+
+// Exactly from at 0 and to at 1
+template<typename L, typename R>
+  requires compatible_vectors<L, R> && std::floating_point<ValueOf<L>>
+constexpr auto Lerp(L &&from, R &&to, ValueOf<L> amount)
+{
+  return std::forward<L>(from) * (1 - amount) + std::forward<R>(to) * amount;
+}
+}// namespace renderer
@@ -9,22 +9,60 @@
 #include <spdlog/spdlog.h>
 
 #include <chrono>
+#include <cstddef>
 #include <iostream>
+#include <renderer/buffer/bufferArena.hpp>
+#include <renderer/buffer/compactVertex.hpp>
+#include <renderer/buffer/vertexLayout.hpp>
 #include <renderer/drawer/drawer.hpp>
 #include <renderer/drawer/openGlDrawer.hpp>
+#include <renderer/object/glObject.hpp>
+#include <renderer/shader/pendingProgram.hpp>
+#include <renderer/shader/programCache.hpp>
+#include <renderer/shader/reloadableProgram.hpp>
 #include <renderer/shader/shader.hpp>
+#include <renderer/utils/fileWatcher.hpp>
+#include <renderer/utils/frameStatistics.hpp>
 #include <renderer/vector/vector.hpp>
-#include <sstream>
+#include <span>
 #include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+
+#ifndef MYPROJECT_LOAD_SHADERS_FROM_DISK
+#include <internal_use_only/shaders.hpp>
+#endif
+
 namespace {
+constexpr std::string_view kVertexShaderName = "newBaseVertexShader.vert.glsl";
+constexpr std::string_view kFragmentShaderName =
+  "ourColourFragmentShader.frag.glsl";
+
+#ifdef MYPROJECT_LOAD_SHADERS_FROM_DISK
 auto ReadFile(std::filesystem::path const &location) -> std::string
 {
-  std::stringstream TempBuffer;
-  TempBuffer << std::ifstream(location).rdbuf();
-  return TempBuffer.str();
+  std::ifstream File(location, std::ios::binary);
+  std::string Contents(std::filesystem::file_size(location), '\0');
+  File.read(Contents.data(), static_cast<std::streamsize>(Contents.size()));
+  return Contents;
+}
+// Development mode: shaders are read from the source tree on every start
+auto LoadShader(std::string_view name) -> std::string
+{
+  return ReadFile(std::filesystem::path(MYPROJECT_SHADER_DIRECTORY) / name);
 }
+#else
+// Shaders are baked into the executable; an unknown name does not compile
+consteval auto LoadShader(std::string_view name) -> std::string_view
+{
+  return myproject::shaders::FindShader(name).value();
+}
+#endif
 // NOLINTBEGIN
+#ifdef MYPROJECT_LOAD_SHADERS_FROM_DISK
 std::string ReadFile(auto...) = delete("No Implicit conversions allowed");
+#endif
 void GLAPIENTRY DebugCallback(GLenum source,
   GLenum type,
   GLuint id,
@@ -45,6 +83,9 @@ void GLAPIENTRY DebugCallback(GLenum source,
 }
 // NOLINTEND
 
+// One megabyte per buffer of static geometry
+constexpr std::size_t kStaticGeometryPageSize = std::size_t{ 1 } << 20U;
+
 // Window dimensions
 
 constexpr int kXStartingWidth = 800;
@@ -62,9 +103,21 @@ void FramebufferSizeCallback(GLFWwindow * /*window*/, int width, int height)
   glViewport(0, 0, width, height);
 }
 
-
+// Interleaved vertex of the scene triangle, read by newBaseVertexShader.
+// The colour is read as normalised bytes, 16 bytes per vertex instead of 24.
+struct ColouredVertex
+{
+  renderer::Vector3<float> Position;
+  renderer::Vector<renderer::gl::Unorm8, 4> Colour;
+};
 }// namespace
 
+template<> struct renderer::gl::VertexMembers<ColouredVertex>
+{
+  static constexpr std::tuple kList{ &ColouredVertex::Position,
+    &ColouredVertex::Colour };
+};
+
 // NOLINTNEXTLINE
 int main()
 {
@@ -102,92 +155,124 @@ int main()
     }
 
     glDebugMessageCallback(DebugCallback, nullptr);
-    // NOLINTNEXTLINE
-    auto Positions = std::array{
-      renderer::Vector3<float>{ { -1.0F, -1.0F, 0.0F } },
-      renderer::Vector3<float>{ { 1.0F, 0.0F, 0.0F } },
-      renderer::Vector3<float>{ { 0.0F, -1.0F, 0.0F } },
-      renderer::Vector3<float>{ { 0.0F, 1.0F, 0.0F } },
-      // NOLINTNEXTLINE
-      renderer::Vector3<float>{ { 0.0F, -0.5F, 0.0F } },
-      renderer::Vector3<float>{ { 0.0F, 0.0F, 1.0F } },
-    };
-    std::cout << Positions[0].X();
-    unsigned int buffer;// NOLINT
-    unsigned int VAO = 0;
-    glGenVertexArrays(1, &VAO);
-    glBindVertexArray(VAO);
-
-    glGenBuffers(1, &buffer);
-    glBindBuffer(GL_ARRAY_BUFFER, buffer);
-    glBufferData(GL_ARRAY_BUFFER,
-      std::size(Positions) * sizeof(renderer::Vector2<float>),
-      &Positions,
-      GL_DYNAMIC_DRAW);
-    glVertexAttribPointer(
-      0, 3, GL_FLOAT, GL_FALSE, sizeof(renderer::Vector3<float>) * 2, nullptr);
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(1,
-      3,
-      GL_FLOAT,
-      GL_FALSE,
-      sizeof(renderer::Vector3<float>) * 2,
+#ifdef MYPROJECT_LOAD_SHADERS_FROM_DISK
+    std::filesystem::path const ShaderDirectory(MYPROJECT_SHADER_DIRECTORY);
+    // Saving a shader under glsl/ rebuilds the program while running
+    renderer::utils::FileWatcher ShaderWatcher(ShaderDirectory);
+#else
+    std::filesystem::path const ShaderDirectory;
+#endif
+    // GL objects live in this scope so they are deleted while the context
+    // still exists, before the window is destroyed
+    {
       // NOLINTNEXTLINE
-      reinterpret_cast<void *>(sizeof(renderer::Vector3<float>)));
-    glEnableVertexAttribArray(1);
-    auto VertexShaderUnitMaker = []() {
-      return renderer::gl::ShaderUnit<GL_VERTEX_SHADER>(
-        ReadFile(std::filesystem::current_path() / "glsl"
-                 / "newBaseVertexShader.vert.glsl"));
-    };
-    auto FragmentShaderUnitMaker = []() {
-      return renderer::gl::ShaderUnit<GL_FRAGMENT_SHADER>(
-        ReadFile(std::filesystem::current_path() / "glsl"
-                 / "ourColourFragmentShader.frag.glsl"));
-    };
-    auto Program = renderer::gl::Program{ VertexShaderUnitMaker(),
-      FragmentShaderUnitMaker() };
-    Program.Use();
-
-
-    // Set initial viewport
-    glViewport(0, 0, WindowWidth, WindowHeight);
-
-    renderer::OpenGLDrawer ClearDrawer(
-      []([[maybe_unused]] GLFWwindow const &window,
-        [[maybe_unused]] std::chrono::nanoseconds delta_time) {
+      auto const Vertices = std::array{
+        ColouredVertex{ { { -1.0F, -1.0F, 0.0F } }, { { 255, 0, 0, 255 } } },
+        ColouredVertex{ { { 0.0F, -1.0F, 0.0F } }, { { 0, 255, 0, 255 } } },
+        // NOLINTNEXTLINE
+        ColouredVertex{ { { 0.0F, -0.5F, 0.0F } }, { { 0, 0, 255, 255 } } },
+      };
+      // Static geometry shares the arena's buffers instead of owning one each
+      renderer::gl::BufferArena StaticGeometry(kStaticGeometryPageSize);
+      auto const TriangleVertices =
+        StaticGeometry.Allocate(std::as_bytes(std::span(Vertices)));
+      // The scene has one vertex array, so a batch of one creates no spares
+      renderer::gl::ObjectPool VertexArrays(
+        renderer::gl::ObjectType::VertexArray, 1);
+      renderer::gl::VertexArray const SceneVertexArray(VertexArrays);
+      SceneVertexArray.SetLayout<ColouredVertex>(
+        TriangleVertices.Buffer, { .Offset = TriangleVertices.Offset });
+      auto const VertexSource = LoadShader(kVertexShaderName);
+      auto const FragmentSource = LoadShader(kFragmentShaderName);
+      // Reuses the linked program from a previous run when the sources and the
+      // driver are unchanged
+      renderer::gl::ProgramBinaryCache ShaderCache(
+        renderer::gl::GetUserCacheDirectory("BphoOptics") / "programs");
+      auto CachedProgram =
+        ShaderCache.Load(ShaderCache.GetKey({ VertexSource, FragmentSource }));
+      // Otherwise compile in the background and only clear the window until
+      // the program has linked
+      if (!CachedProgram.has_value()) {
+        renderer::gl::SetMaxShaderCompilerThreads(
+          // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+          reinterpret_cast<GLADloadproc>(glfwGetProcAddress));
+      }
+      renderer::gl::ReloadableProgram SceneProgram(
+        { { GL_VERTEX_SHADER,
+            ShaderDirectory / kVertexShaderName,
+            std::string(VertexSource) },
+          { GL_FRAGMENT_SHADER,
+            ShaderDirectory / kFragmentShaderName,
+            std::string(FragmentSource) } },
+        std::move(CachedProgram));
+
+      // Set initial viewport
+      glViewport(0, 0, WindowWidth, WindowHeight);
+
+      auto ClearDrawer =
+        []([[maybe_unused]] GLFWwindow const &window,
+          [[maybe_unused]] std::chrono::nanoseconds delta_time) {
         // NOLINTNEXTLINE
         glClearColor(0.2F, 0.3F, 0.3F, 1.0F);
         glClear(GL_COLOR_BUFFER_BIT);
-      });
-
-    renderer::OpenGLDrawer TriangleDrawer(
-      [&Program, &VAO](GLFWwindow const & /*window*/,
-        [[maybe_unused]] std::chrono::nanoseconds delta_time) -> void {
-        Program.Use();
-        glBindVertexArray(VAO);
-        glDrawArrays(GL_TRIANGLES, 0, 3);
-      });
-    auto PreviousTime = std::chrono::system_clock::now();
-    // Main loop
-    while (glfwWindowShouldClose(Window) == 0) {
-      auto const StartTime = std::chrono::system_clock::now();
-      PreviousTime = StartTime;
-      std::chrono::nanoseconds const DeltaTime = StartTime - PreviousTime;
-      // Clear screen
-      ClearDrawer.Draw(*Window, DeltaTime);
-
-      //
-      // RENDER
-      //
-      TriangleDrawer.Draw(*Window, DeltaTime);
-
-      // Swap buffers and poll events
-      glfwSwapBuffers(Window);
-      glfwPollEvents();
+      };
+
+      // The queue binds each submission's program and VAO, skipping binds the
+      // previous submission already made
+      auto SubmitScene = [&](renderer::OpenGLDrawerQueue &queue) {
+        queue.Submit({ .Program = SceneProgram.GetProgram().GetProgramID(),
+                       .VertexArray = SceneVertexArray.GetName() },
+          [](GLFWwindow const & /*window*/,
+            [[maybe_unused]] std::chrono::nanoseconds delta_time) -> void {
+            glDrawArrays(GL_TRIANGLES, 0, 3);
+          });
+      };
+      renderer::OpenGLDrawerQueue SceneDrawers;
+      if (SceneProgram.HasProgram()) { SubmitScene(SceneDrawers); }
+      // Drawn in order each frame, with every call inlined
+      auto FrameDrawers = renderer::MakeOpenGLDrawerPipeline(
+        ClearDrawer, std::move(SceneDrawers));
+      auto PreviousTime = std::chrono::system_clock::now();
+      // Main loop
+      while (glfwWindowShouldClose(Window) == 0) {
+        auto const StartTime = std::chrono::system_clock::now();
+        PreviousTime = StartTime;
+        std::chrono::nanoseconds const DeltaTime = StartTime - PreviousTime;
+#ifdef MYPROJECT_LOAD_SHADERS_FROM_DISK
+        auto const ShaderChanges = ShaderWatcher.TakeChanges();
+#else
+        std::span<renderer::utils::ChangedFile const> const ShaderChanges;
+#endif
+        // Swapped between frames; the scene is resubmitted for the new ID
+        if (SceneProgram.Update(ShaderChanges)) {
+          auto const Files = SceneProgram.GetFiles();
+          ShaderCache.Store(
+            ShaderCache.GetKey({ Files[0].Source, Files[1].Source }),
+            SceneProgram.GetProgram());
+          auto &Queue = FrameDrawers.Get<1>();
+          Queue.Clear();
+          SubmitScene(Queue);
+        }
+        // Clear screen, then RENDER
+        FrameDrawers.Draw(*Window, DeltaTime);
+
+        renderer::FrameStatistics Statistics =
+          FrameDrawers.Get<1>().GetStatistics();
+        if (SceneProgram.HasProgram()) {
+          SceneProgram.GetProgram().CollectStatistics(Statistics);
+        }
+        spdlog::trace("Frame: {} drawers, {} binds skipped, {} uniform uploads "
+                      "({} elided)",
+          Statistics.DrawerCalls,
+          Statistics.RedundantBindsSkipped,
+          Statistics.UniformUploads,
+          Statistics.UniformUploadsElided);
+
+        // Swap buffers and poll events
+        glfwSwapBuffers(Window);
+        glfwPollEvents();
+      }
     }
-    glDeleteBuffers(1, &buffer);
-    glDeleteVertexArrays(1, &VAO);
 
     // Clean up
     glfwDestroyWindow(Window);
@@ -0,0 +1,173 @@
+#include <renderer/buffer/bufferArena.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <utility>
+
+renderer::gl::RangeAllocator::RangeAllocator(std::size_t capacity)
+  : m_Capacity(capacity)
+{
+  if (capacity != 0) { m_FreeBlocks.emplace(0, capacity); }
+}
+
+auto renderer::gl::RangeAllocator::Allocate(std::size_t size,
+  std::size_t alignment) -> std::optional<std::size_t>
+{
+  assert(alignment != 0 && (alignment & (alignment - 1)) == 0);
+  if (size == 0) { return std::nullopt; }
+  auto Best = m_FreeBlocks.end();
+  std::size_t BestStart{};
+  for (auto Block = m_FreeBlocks.begin(); Block != m_FreeBlocks.end();
+       ++Block) {
+    auto const [Offset, Size] = *Block;
+    auto const Start = (Offset + alignment - 1) & ~(alignment - 1);
+    if (Start + size > Offset + Size) { continue; }
+    if (Best == m_FreeBlocks.end() || Size < Best->second) {
+      Best = Block;
+      BestStart = Start;
+    }
+  }
+  if (Best == m_FreeBlocks.end()) { return std::nullopt; }
+
+  // The alignment gap in front stays free, as does the tail
+  auto const [Offset, Size] = *Best;
+  m_FreeBlocks.erase(Best);
+  if (BestStart > Offset) { m_FreeBlocks.emplace(Offset, BestStart - Offset); }
+  auto const End = BestStart + size;
+  if (End < Offset + Size) { m_FreeBlocks.emplace(End, Offset + Size - End); }
+  m_Used += size;
+  ++m_Allocations;
+  return BestStart;
+}
+
+void renderer::gl::RangeAllocator::Free(std::size_t offset, std::size_t size)
+{
+  assert(offset + size <= m_Capacity && m_Used >= size);
+  m_Used -= size;
+  --m_Allocations;
+  auto Block = m_FreeBlocks.emplace(offset, size).first;
+  // Merge with the following and then the preceding free block
+  if (auto Next = std::next(Block);
+      Next != m_FreeBlocks.end() && offset + size == Next->first) {
+    Block->second += Next->second;
+    m_FreeBlocks.erase(Next);
+  }
+  if (Block != m_FreeBlocks.begin()) {
+    auto Previous = std::prev(Block);
+    if (Previous->first + Previous->second == offset) {
+      Previous->second += Block->second;
+      m_FreeBlocks.erase(Block);
+    }
+  }
+}
+
+auto renderer::gl::RangeAllocator::GetStatistics() const noexcept
+  -> ArenaStatistics
+{
+  ArenaStatistics Statistics{ .Capacity = m_Capacity,
+    .Used = m_Used,
+    .Allocations = m_Allocations,
+    .FreeBlocks = m_FreeBlocks.size() };
+  for (auto const &[Offset, Size] : m_FreeBlocks) {
+    Statistics.LargestFreeBlock = std::max(Statistics.LargestFreeBlock, Size);
+  }
+  return Statistics;
+}
+
+renderer::gl::BufferArena::BufferArena(std::size_t page_size,
+  GLbitfield storage_flags)
+  : m_PageSize(page_size), m_StorageFlags(storage_flags)
+{}
+
+renderer::gl::BufferArena::BufferArena(BufferArena &&other) noexcept
+  : m_PageSize(other.m_PageSize), m_StorageFlags(other.m_StorageFlags),
+    m_Pages(std::exchange(other.m_Pages, {}))
+{}
+
+auto renderer::gl::BufferArena::operator=(BufferArena &&other) noexcept
+  -> BufferArena &
+{
+  if (this != &other) {
+    Release();
+    m_PageSize = other.m_PageSize;
+    m_StorageFlags = other.m_StorageFlags;
+    m_Pages = std::exchange(other.m_Pages, {});
+  }
+  return *this;
+}
+
+void renderer::gl::BufferArena::Release() noexcept
+{
+  for (auto const &Page : m_Pages) { glDeleteBuffers(1, &Page.Buffer); }
+  m_Pages.clear();
+}
+
+auto renderer::gl::BufferArena::Allocate(std::size_t size,
+  std::size_t alignment) -> BufferAllocation
+{
+  if (size == 0) {
+    throw std::invalid_argument("BufferArena cannot allocate zero bytes");
+  }
+  auto MakeAllocation = [size](Page const &page, std::size_t offset) {
+    return BufferAllocation{ page.Buffer,
+      static_cast<GLintptr>(offset),
+      static_cast<GLsizeiptr>(size) };
+  };
+  for (auto &Page : m_Pages) {
+    if (auto const Offset = Page.Ranges.Allocate(size, alignment)) {
+      return MakeAllocation(Page, *Offset);
+    }
+  }
+  // Buffer offsets start aligned, so a fresh page always fits the request
+  Page NewPage{ 0, RangeAllocator(std::max(size, m_PageSize)) };
+  glCreateBuffers(1, &NewPage.Buffer);
+  glNamedBufferStorage(NewPage.Buffer,
+    static_cast<GLsizeiptr>(NewPage.Ranges.GetCapacity()),
+    nullptr,
+    m_StorageFlags);
+  auto const Offset = NewPage.Ranges.Allocate(size, alignment).value();
+  return MakeAllocation(m_Pages.emplace_back(std::move(NewPage)), Offset);
+}
+
+auto renderer::gl::BufferArena::Allocate(std::span<std::byte const> data,
+  std::size_t alignment) -> BufferAllocation
+{
+  auto Allocation = Allocate(data.size(), alignment);
+  Upload(Allocation, data);
+  return Allocation;
+}
+
+void renderer::gl::BufferArena::Free(BufferAllocation const &allocation)
+{
+  auto Owner = std::ranges::find(m_Pages, allocation.Buffer, &Page::Buffer);
+  assert(Owner != m_Pages.end() && "Allocation is not from this arena");
+  if (Owner == m_Pages.end()) { return; }
+  Owner->Ranges.Free(static_cast<std::size_t>(allocation.Offset),
+    static_cast<std::size_t>(allocation.Size));
+}
+
+void renderer::gl::BufferArena::Upload(BufferAllocation const &allocation,
+  std::span<std::byte const> data,
+  GLintptr offset) noexcept
+{
+  assert(offset + static_cast<GLsizeiptr>(data.size()) <= allocation.Size);
+  glNamedBufferSubData(allocation.Buffer,
+    allocation.Offset + offset,
+    static_cast<GLsizeiptr>(data.size()),
+    data.data());
+}
+
+auto renderer::gl::BufferArena::GetStatistics() const noexcept
+  -> ArenaStatistics
+{
+  ArenaStatistics Statistics;
+  for (auto const &Page : m_Pages) {
+    Statistics += Page.Ranges.GetStatistics();
+  }
+  return Statistics;
+}
@@ -0,0 +1,271 @@
+#include <renderer/colour/colourConversion.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <renderer/colour/colour.hpp>
+#include <renderer/vector/vector.hpp>
+#include <span>
+#include <type_traits>
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace {
+constexpr std::size_t kCodes = 256;
+constexpr float kChannelMax = 255.0F;
+
+template<typename T> auto SrgbToLinearImpl(T encoded) noexcept -> T
+{
+  constexpr T kThreshold = 0.04045;
+  if (encoded <= kThreshold) { return encoded / T{ 12.92 }; }
+  return std::pow((encoded + T{ 0.055 }) / T{ 1.055 }, T{ 2.4 });
+}
+
+template<typename T> auto LinearToSrgbImpl(T linear) noexcept -> T
+{
+  constexpr T kThreshold = 0.0031308;
+  if (linear <= kThreshold) { return linear * T{ 12.92 }; }
+  return T{ 1.055 } * std::pow(linear, T{ 1 } / T{ 2.4 }) - T{ 0.055 };
+}
+
+// Both tables are evaluated in double precision and rounded once
+auto GetDecodeTable() noexcept -> std::array<float, kCodes> const &
+{
+  static auto const kTable = [] {
+    std::array<float, kCodes> Table{};
+    for (std::size_t Code = 0; Code < kCodes; ++Code) {
+      Table[Code] = static_cast<float>(SrgbToLinearImpl(
+        static_cast<double>(Code) / static_cast<double>(kChannelMax)));
+    }
+    return Table;
+  }();
+  return kTable;
+}
+
+// Linear value where the nearest code changes from Code to Code + 1
+auto GetEncodeThresholds() noexcept -> std::array<float, kCodes - 1> const &
+{
+  static auto const kThresholds = [] {
+    std::array<float, kCodes - 1> Thresholds{};
+    for (std::size_t Code = 0; Code + 1 < kCodes; ++Code) {
+      Thresholds[Code] = static_cast<float>(
+        SrgbToLinearImpl((static_cast<double>(Code) + 0.5)
+                         / static_cast<double>(kChannelMax)));
+    }
+    return Thresholds;
+  }();
+  return kThresholds;
+}
+
+// Runs a flat channel kernel over arrays of colour objects. The objects are
+// copied through staging arrays rather than aliased as channel arrays,
+// which keeps the access well defined; the blocks stay in L1.
+template<typename InChannel,
+  typename OutChannel,
+  typename From,
+  typename To,
+  typename Kernel>
+void ConvertStaged(std::span<From const> source,
+  std::span<To> destination,
+  Kernel kernel) noexcept
+{
+  static_assert(std::is_trivially_copyable_v<From>
+                && std::is_trivially_copyable_v<To>);
+  constexpr std::size_t kChannels = sizeof(From) / sizeof(InChannel);
+  static_assert(sizeof(From) == kChannels * sizeof(InChannel)
+                && sizeof(To) == kChannels * sizeof(OutChannel));
+  constexpr std::size_t kBlock = 64;
+  std::array<InChannel, kBlock * kChannels> In{};
+  std::array<OutChannel, kBlock * kChannels> Out{};
+  for (std::size_t Start = 0; Start < source.size(); Start += kBlock) {
+    auto const Count = std::min(kBlock, source.size() - Start);
+    std::memcpy(In.data(), source.data() + Start, Count * sizeof(From));
+    kernel(std::span<InChannel const>(In.data(), Count * kChannels),
+      std::span<OutChannel>(Out));
+    std::memcpy(static_cast<void *>(destination.data() + Start),
+      Out.data(),
+      Count * sizeof(To));
+  }
+}
+}// namespace
+
+auto renderer::SrgbToLinear(float encoded) noexcept -> float
+{
+  return SrgbToLinearImpl(encoded);
+}
+
+auto renderer::LinearToSrgb(float linear) noexcept -> float
+{
+  return LinearToSrgbImpl(linear);
+}
+
+auto renderer::DecodeSrgb(std::uint8_t encoded) noexcept -> float
+{
+  return GetDecodeTable()[encoded];
+}
+
+auto renderer::EncodeSrgb(float linear) noexcept -> std::uint8_t
+{
+  if (!(linear >= 0.0F)) { return 0; }
+  auto const &Thresholds = GetEncodeThresholds();
+  return static_cast<std::uint8_t>(
+    std::upper_bound(Thresholds.begin(), Thresholds.end(), linear)
+    - Thresholds.begin());
+}
+
+void renderer::NormaliseChannels(std::span<std::uint8_t const> source,
+  std::span<float> destination) noexcept
+{
+  assert(destination.size() >= source.size());
+  std::size_t Index = 0;
+#if defined(__SSE2__)
+  // Sixteen bytes widened to four float vectors. The division is exact
+  // IEEE division, like the scalar constructors, so no reciprocal is used.
+  __m128i const Zero = _mm_setzero_si128();
+  __m128 const Max = _mm_set1_ps(kChannelMax);
+  for (; Index + 16 <= source.size(); Index += 16) {
+    auto const Bytes = _mm_loadu_si128(
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+      reinterpret_cast<__m128i const *>(source.data() + Index));
+    auto const Low = _mm_unpacklo_epi8(Bytes, Zero);
+    auto const High = _mm_unpackhi_epi8(Bytes, Zero);
+    std::array const Words{ _mm_unpacklo_epi16(Low, Zero),
+      _mm_unpackhi_epi16(Low, Zero),
+      _mm_unpacklo_epi16(High, Zero),
+      _mm_unpackhi_epi16(High, Zero) };
+    for (std::size_t Part = 0; Part < Words.size(); ++Part) {
+      _mm_storeu_ps(destination.data() + Index + 4 * Part,
+        _mm_div_ps(_mm_cvtepi32_ps(Words[Part]), Max));
+    }
+  }
+#endif
+  for (; Index < source.size(); ++Index) {
+    destination[Index] = RedNormalised(Red{ source[Index] }).Value();
+  }
+}
+
+void renderer::QuantiseChannels(std::span<float const> source,
+  std::span<std::uint8_t> destination) noexcept
+{
+  assert(destination.size() >= source.size());
+  std::size_t Index = 0;
+#if defined(__SSE2__)
+  // maxps returns its second operand for NaN, so NaN clamps to 0 as in the
+  // scalar version; the multiply and add stay separate instructions
+  __m128 const Zero = _mm_setzero_ps();
+  __m128 const One = _mm_set1_ps(1.0F);
+  __m128 const Max = _mm_set1_ps(kChannelMax);
+  __m128 const Half = _mm_set1_ps(0.5F);
+  auto Quantise = [&](std::size_t offset) {
+    auto const Clamped =
+      _mm_min_ps(_mm_max_ps(_mm_loadu_ps(source.data() + offset), Zero), One);
+    return _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(Clamped, Max), Half));
+  };
+  for (; Index + 16 <= source.size(); Index += 16) {
+    auto const Low = _mm_packs_epi32(Quantise(Index), Quantise(Index + 4));
+    auto const High =
+      _mm_packs_epi32(Quantise(Index + 8), Quantise(Index + 12));
+    _mm_storeu_si128(
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+      reinterpret_cast<__m128i *>(destination.data() + Index),
+      _mm_packus_epi16(Low, High));
+  }
+#endif
+  for (; Index < source.size(); ++Index) {
+    destination[Index] = QuantiseChannel(source[Index]);
+  }
+}
+
+void renderer::NormaliseChannels(std::span<RGBColour const> source,
+  std::span<RBGColourNormalised> destination) noexcept
+{
+  assert(destination.size() >= source.size());
+  ConvertStaged<std::uint8_t, float>(source,
+    destination,
+    [](std::span<std::uint8_t const> in, std::span<float> out) {
+      NormaliseChannels(in, out);
+    });
+}
+
+void renderer::QuantiseChannels(std::span<RBGColourNormalised const> source,
+  std::span<RGBColour> destination) noexcept
+{
+  assert(destination.size() >= source.size());
+  ConvertStaged<float, std::uint8_t>(source,
+    destination,
+    [](std::span<float const> in, std::span<std::uint8_t> out) {
+      QuantiseChannels(in, out);
+    });
+}
+
+void renderer::UnpackRGBA8(std::span<std::uint32_t const> source,
+  std::span<Vector4<float>> destination) noexcept
+{
+  assert(destination.size() >= source.size());
+  if constexpr (std::endian::native == std::endian::little) {
+    // The bytes of each pixel are already in red, green, blue, alpha order
+    ConvertStaged<std::uint8_t, float>(source,
+      destination,
+      [](std::span<std::uint8_t const> in, std::span<float> out) {
+        NormaliseChannels(in, out);
+      });
+  } else {
+    for (std::size_t Index = 0; Index < source.size(); ++Index) {
+      for (std::size_t Channel = 0; Channel < 4; ++Channel) {
+        auto const Byte =
+          static_cast<std::uint8_t>(source[Index] >> (8 * Channel));
+        destination[Index].m_Values[Channel] =
+          RedNormalised(Red{ Byte }).Value();
+      }
+    }
+  }
+}
+
+void renderer::PackRGBA8(std::span<Vector4<float> const> source,
+  std::span<std::uint32_t> destination) noexcept
+{
+  assert(destination.size() >= source.size());
+  if constexpr (std::endian::native == std::endian::little) {
+    ConvertStaged<float, std::uint8_t>(source,
+      destination,
+      [](std::span<float const> in, std::span<std::uint8_t> out) {
+        QuantiseChannels(in, out);
+      });
+  } else {
+    for (std::size_t Index = 0; Index < source.size(); ++Index) {
+      std::uint32_t Pixel = 0;
+      for (std::size_t Channel = 0; Channel < 4; ++Channel) {
+        Pixel |= std::uint32_t{ QuantiseChannel(
+                   source[Index].m_Values[Channel]) }
+                 << (8 * Channel);
+      }
+      destination[Index] = Pixel;
+    }
+  }
+}
+
+void renderer::DecodeSrgb(std::span<std::uint8_t const> source,
+  std::span<float> destination) noexcept
+{
+  assert(destination.size() >= source.size());
+  auto const &Table = GetDecodeTable();
+  for (std::size_t Index = 0; Index < source.size(); ++Index) {
+    destination[Index] = Table[source[Index]];
+  }
+}
+
+void renderer::EncodeSrgb(std::span<float const> source,
+  std::span<std::uint8_t> destination) noexcept
+{
+  assert(destination.size() >= source.size());
+  for (std::size_t Index = 0; Index < source.size(); ++Index) {
+    destination[Index] = EncodeSrgb(source[Index]);
+  }
+}
@@ -0,0 +1,202 @@
+#include <renderer/buffer/compactVertex.hpp>
+
+#include <cassert>
+#include <cstddef>
+#include <renderer/colour/colour.hpp>
+#include <renderer/point/point.hpp>
+#include <span>
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#if defined(__GNUC__) || defined(__clang__)
+#define RENDERER_HAS_F16C_PATH 1
+#endif
+#endif
+
+namespace {
+using renderer::gl::CompactPoint;
+using renderer::gl::Half;
+using renderer::gl::Snorm16;
+using renderer::gl::Unorm8;
+
+constexpr Half kHalfOne = renderer::gl::ToHalf(1.0F);
+constexpr Unorm8 kOpaque{ 255 };
+
+auto PackColour(renderer::RGBColour const &colour) noexcept
+  -> renderer::Vector<Unorm8, 4>
+{
+  return { { Unorm8{ colour.Red().Value },
+    Unorm8{ colour.Green().Value },
+    Unorm8{ colour.Blue().Value },
+    kOpaque } };
+}
+
+template<std::size_t Dimension, typename Component, typename Convert>
+void PackScalar(std::span<renderer::Point<float, Dimension> const> source,
+  std::span<CompactPoint<Dimension, Component>> destination,
+  Convert convert,
+  Component one) noexcept
+{
+  for (std::size_t Index = 0; Index < source.size(); ++Index) {
+    auto const &[Position, Colour] = source[Index];
+    auto &Packed = destination[Index];
+    for (std::size_t Axis = 0; Axis < Dimension; ++Axis) {
+      Packed.Position.m_Values[Axis] = convert(Position.m_Values[Axis]);
+    }
+    if constexpr (Dimension == 3) { Packed.Position.m_Values[3] = one; }
+    Packed.Colour = PackColour(Colour);
+  }
+}
+
+#ifdef RENDERER_HAS_F16C_PATH
+auto HasF16C() noexcept -> bool
+{
+  static bool const kSupported = __builtin_cpu_supports("f16c") != 0;
+  return kSupported;
+}
+
+// One conversion instruction per point. A Point3<float> is 16 bytes, so the
+// four float load stays inside the point; its last lane (colour bytes) is
+// replaced with 1.0 before converting.
+__attribute__((target("f16c"))) void PackF16C(
+  std::span<renderer::Point3<float> const> source,
+  std::span<CompactPoint<3, Half>> destination) noexcept
+{
+  static_assert(sizeof(renderer::Point3<float>) == 4 * sizeof(float));
+  __m128 const One = _mm_set1_ps(1.0F);
+  for (std::size_t Index = 0; Index < source.size(); ++Index) {
+    auto const Position =
+      _mm_loadu_ps(source[Index].m_PositionVector.m_Values.data());
+    auto const Halves = _mm_cvtps_ph(
+      _mm_blend_ps(Position, One, 0b1000), _MM_FROUND_TO_NEAREST_INT);
+    _mm_storel_epi64(
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+      reinterpret_cast<__m128i *>(
+        destination[Index].Position.m_Values.data()),
+      Halves);
+    destination[Index].Colour = PackColour(source[Index].m_ColourOfPoint);
+  }
+}
+
+__attribute__((target("f16c"))) void PackF16C(
+  std::span<renderer::Point2<float> const> source,
+  std::span<CompactPoint<2, Half>> destination) noexcept
+{
+  for (std::size_t Index = 0; Index < source.size(); ++Index) {
+    auto const Position = _mm_castsi128_ps(_mm_loadl_epi64(
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+      reinterpret_cast<__m128i const *>(
+        source[Index].m_PositionVector.m_Values.data())));
+    _mm_storeu_si32(destination[Index].Position.m_Values.data(),
+      _mm_cvtps_ph(Position, _MM_FROUND_TO_NEAREST_INT));
+    destination[Index].Colour = PackColour(source[Index].m_ColourOfPoint);
+  }
+}
+#endif
+
+#ifdef __SSE2__
+// Same arithmetic as ToSnorm16: clamp, scale, add 0.5 away from zero and
+// truncate, so both paths agree bit for bit
+inline auto ToSnorm16(__m128 values) noexcept -> __m128i
+{
+  auto const Scaled = _mm_mul_ps(
+    _mm_min_ps(_mm_max_ps(values, _mm_set1_ps(-1.0F)), _mm_set1_ps(1.0F)),
+    _mm_set1_ps(32767.0F));
+  auto const Rounding = _mm_or_ps(
+    _mm_and_ps(Scaled, _mm_set1_ps(-0.0F)), _mm_set1_ps(0.5F));
+  auto const Integers = _mm_cvttps_epi32(_mm_add_ps(Scaled, Rounding));
+  return _mm_packs_epi32(Integers, Integers);
+}
+
+void PackSse2(std::span<renderer::Point3<float> const> source,
+  std::span<CompactPoint<3, Snorm16>> destination) noexcept
+{
+  // Keeps x, y and z of a four float load and sets w to 1
+  auto const Xyz = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+  auto const W = _mm_set_ps(1.0F, 0.0F, 0.0F, 0.0F);
+  for (std::size_t Index = 0; Index < source.size(); ++Index) {
+    auto const Position = _mm_or_ps(
+      _mm_and_ps(
+        _mm_loadu_ps(source[Index].m_PositionVector.m_Values.data()), Xyz),
+      W);
+    _mm_storel_epi64(
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+      reinterpret_cast<__m128i *>(
+        destination[Index].Position.m_Values.data()),
+      ToSnorm16(Position));
+    destination[Index].Colour = PackColour(source[Index].m_ColourOfPoint);
+  }
+}
+
+void PackSse2(std::span<renderer::Point2<float> const> source,
+  std::span<CompactPoint<2, Snorm16>> destination) noexcept
+{
+  for (std::size_t Index = 0; Index < source.size(); ++Index) {
+    auto const Position = _mm_castsi128_ps(_mm_loadl_epi64(
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+      reinterpret_cast<__m128i const *>(
+        source[Index].m_PositionVector.m_Values.data())));
+    _mm_storeu_si32(
+      destination[Index].Position.m_Values.data(), ToSnorm16(Position));
+    destination[Index].Colour = PackColour(source[Index].m_ColourOfPoint);
+  }
+}
+#endif
+
+template<std::size_t Dimension>
+void PackHalf(std::span<renderer::Point<float, Dimension> const> source,
+  std::span<CompactPoint<Dimension, Half>> destination) noexcept
+{
+  assert(destination.size() >= source.size());
+#ifdef RENDERER_HAS_F16C_PATH
+  if (HasF16C()) {
+    PackF16C(source, destination);
+    return;
+  }
+#endif
+  PackScalar(source, destination, renderer::gl::ToHalf, kHalfOne);
+}
+
+template<std::size_t Dimension>
+void PackSnorm16(std::span<renderer::Point<float, Dimension> const> source,
+  std::span<CompactPoint<Dimension, Snorm16>> destination) noexcept
+{
+  assert(destination.size() >= source.size());
+#ifdef __SSE2__
+  PackSse2(source, destination);
+#else
+  PackScalar(source,
+    destination,
+    renderer::gl::ToSnorm16,
+    renderer::gl::ToSnorm16(1.0F));
+#endif
+}
+}// namespace
+
+void renderer::gl::PackPoints(
+  std::span<renderer::Point2<float> const> source,
+  std::span<CompactPoint2<Half>> destination) noexcept
+{
+  PackHalf(source, destination);
+}
+
+void renderer::gl::PackPoints(
+  std::span<renderer::Point3<float> const> source,
+  std::span<CompactPoint3<Half>> destination) noexcept
+{
+  PackHalf(source, destination);
+}
+
+void renderer::gl::PackPoints(
+  std::span<renderer::Point2<float> const> source,
+  std::span<CompactPoint2<Snorm16>> destination) noexcept
+{
+  PackSnorm16(source, destination);
+}
+
+void renderer::gl::PackPoints(
+  std::span<renderer::Point3<float> const> source,
+  std::span<CompactPoint3<Snorm16>> destination) noexcept
+{
+  PackSnorm16(source, destination);
+}
@@ -0,0 +1,45 @@
+#include <renderer/shader/computeProgram.hpp>
+
+#include <array>
+#include <renderer/shader/shader.hpp>
+#include <string_view>
+
+renderer::gl::ComputeProgram::ComputeProgram(std::string_view source)
+  : m_Program(ShaderUnit<GL_COMPUTE_SHADER>(source))
+{
+  std::array<GLint, 3> LocalSize{};
+  glGetProgramiv(
+    m_Program.GetProgramID(), GL_COMPUTE_WORK_GROUP_SIZE, LocalSize.data());
+  m_LocalSize = { static_cast<GLuint>(LocalSize[0]),
+    static_cast<GLuint>(LocalSize[1]),
+    static_cast<GLuint>(LocalSize[2]) };
+}
+
+void renderer::gl::ComputeProgram::BindStorageBuffer(GLuint binding,
+  GLuint buffer,
+  GLintptr offset,
+  GLsizeiptr size) noexcept
+{
+  if (size == 0) {
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, binding, buffer);
+  } else {
+    glBindBufferRange(GL_SHADER_STORAGE_BUFFER, binding, buffer, offset, size);
+  }
+}
+
+void renderer::gl::ComputeProgram::BindImage(GLuint unit,
+  GLuint texture,
+  GLenum access,
+  GLenum format,
+  GLint level) noexcept
+{
+  glBindImageTexture(unit, texture, level, GL_FALSE, 0, access, format);
+}
+
+void renderer::gl::ComputeProgram::Dispatch(DispatchSize groups,
+  GLbitfield barriers) const noexcept
+{
+  m_Program.Use();
+  glDispatchCompute(groups.X, groups.Y, groups.Z);
+  if (barriers != 0) { glMemoryBarrier(barriers); }
+}
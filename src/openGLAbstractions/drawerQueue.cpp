@@ -0,0 +1,32 @@
+#include <renderer/drawer/drawerQueue.hpp>
+
+void renderer::drawer::GLStateBinder::BindProgram(GLuint program) noexcept
+{
+  glUseProgram(program);
+}
+void renderer::drawer::GLStateBinder::BindVertexArray(
+  GLuint vertex_array) noexcept
+{
+  glBindVertexArray(vertex_array);
+}
+void renderer::drawer::GLStateBinder::BindTexture(GLuint unit,
+  GLuint texture) noexcept
+{
+  glBindTextureUnit(unit, texture);
+}
+void renderer::drawer::GLStateBinder::SetBlendMode(BlendMode mode) noexcept
+{
+  switch (mode) {
+  case BlendMode::Opaque:
+    glDisable(GL_BLEND);
+    break;
+  case BlendMode::Alpha:
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    break;
+  case BlendMode::Additive:
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_ONE, GL_ONE);
+    break;
+  }
+}
@@ -0,0 +1,127 @@
+#include <renderer/utils/fileWatcher.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <ios>
+#include <map>
+#include <mutex>
+#include <spdlog/spdlog.h>
+#include <stop_token>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+renderer::utils::FileWatcher::FileWatcher(std::filesystem::path directory,
+  std::chrono::milliseconds poll_interval)
+  : m_Directory(std::move(directory)), m_PollInterval(poll_interval),
+    m_Thread([this](std::stop_token const &stop_token) { Run(stop_token); })
+{}
+
+auto renderer::utils::FileWatcher::TakeChanges() -> std::vector<ChangedFile>
+{
+  std::vector<ChangedFile> Changes;
+  std::scoped_lock const Lock(m_Mutex);
+  Changes.swap(m_Changes);
+  return Changes;
+}
+
+void renderer::utils::FileWatcher::Publish(std::filesystem::path const &path)
+{
+  std::error_code Error;
+  auto const Size = std::filesystem::file_size(path, Error);
+  // Editors briefly remove or truncate files while saving; a later event
+  // delivers the finished file
+  if (Error || !std::filesystem::is_regular_file(path, Error)) { return; }
+  std::ifstream File(path, std::ios::binary);
+  std::string Contents(Size, '\0');
+  File.read(Contents.data(), static_cast<std::streamsize>(Contents.size()));
+  if (!File) { return; }
+
+  std::scoped_lock const Lock(m_Mutex);
+  auto Existing = std::ranges::find(m_Changes, path, &ChangedFile::Path);
+  if (Existing != m_Changes.end()) {
+    Existing->Contents = std::move(Contents);
+  } else {
+    m_Changes.push_back(ChangedFile{ path, std::move(Contents) });
+  }
+}
+
+void renderer::utils::FileWatcher::Run(std::stop_token const &stop_token)
+{
+  if (!RunNotified(stop_token)) { RunPolling(stop_token); }
+}
+
+auto renderer::utils::FileWatcher::RunNotified(
+  [[maybe_unused]] std::stop_token const &stop_token) -> bool
+{
+#ifdef __linux__
+  int const Notifier = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (Notifier < 0) { return false; }
+  // Saving through a rename (as many editors do) shows up as IN_MOVED_TO
+  if (inotify_add_watch(
+        Notifier, m_Directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO)
+      < 0) {
+    spdlog::warn("Cannot watch {}, falling back to polling",
+      m_Directory.string());
+    close(Notifier);
+    return false;
+  }
+  alignas(inotify_event) std::array<char, 4096> Buffer{};
+  while (!stop_token.stop_requested()) {
+    pollfd Descriptor{ .fd = Notifier, .events = POLLIN, .revents = 0 };
+    if (poll(&Descriptor, 1, static_cast<int>(m_PollInterval.count())) <= 0) {
+      continue;
+    }
+    auto const Length = read(Notifier, Buffer.data(), Buffer.size());
+    for (ssize_t Offset = 0; Offset < Length;) {
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+      auto const *Event = reinterpret_cast<inotify_event const *>(
+        std::next(Buffer.data(), Offset));
+      if (Event->len > 0) {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-array-to-pointer-decay)
+        Publish(m_Directory / Event->name);
+      }
+      Offset += static_cast<ssize_t>(sizeof(inotify_event) + Event->len);
+    }
+  }
+  close(Notifier);
+  return true;
+#else
+  return false;
+#endif
+}
+
+void renderer::utils::FileWatcher::RunPolling(
+  std::stop_token const &stop_token)
+{
+  std::map<std::filesystem::path, std::filesystem::file_time_type> WriteTimes;
+  bool FirstScan = true;
+  while (!stop_token.stop_requested()) {
+    std::error_code Error;
+    for (auto const &Entry :
+      std::filesystem::directory_iterator(m_Directory, Error)) {
+      auto const Time = Entry.last_write_time(Error);
+      if (Error) { continue; }
+      auto [Position, Inserted] = WriteTimes.try_emplace(Entry.path(), Time);
+      if (!Inserted && Position->second != Time) {
+        Position->second = Time;
+        Publish(Entry.path());
+      } else if (Inserted && !FirstScan) {
+        Publish(Entry.path());
+      }
+    }
+    FirstScan = false;
+    std::this_thread::sleep_for(m_PollInterval);
+  }
+}
@@ -0,0 +1,201 @@
+#include <renderer/object/glObject.hpp>
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+renderer::gl::ObjectPool::ObjectPool(ObjectType type, std::size_t batch_size)
+  : m_Type(type), m_TextureTarget(GL_TEXTURE_2D),
+    m_BatchSize(batch_size == 0 ? 1 : batch_size)
+{
+  m_Created.reserve(m_BatchSize);
+  m_Released.reserve(m_BatchSize);
+}
+
+renderer::gl::ObjectPool::ObjectPool(GLenum texture_target,
+  std::size_t batch_size)
+  : ObjectPool(ObjectType::Texture, batch_size)
+{
+  m_TextureTarget = texture_target;
+}
+
+renderer::gl::ObjectPool::~ObjectPool()
+{
+  Delete(m_Created);
+  Delete(m_Released);
+}
+
+void renderer::gl::ObjectPool::Delete(
+  std::span<GLuint const> names) const noexcept
+{
+  if (names.empty()) { return; }
+  auto const Count = static_cast<GLsizei>(names.size());
+  switch (m_Type) {
+  case ObjectType::Buffer:
+    glDeleteBuffers(Count, names.data());
+    break;
+  case ObjectType::VertexArray:
+    glDeleteVertexArrays(Count, names.data());
+    break;
+  case ObjectType::Texture:
+    glDeleteTextures(Count, names.data());
+    break;
+  case ObjectType::Framebuffer:
+    glDeleteFramebuffers(Count, names.data());
+    break;
+  }
+}
+
+auto renderer::gl::ObjectPool::Acquire() -> GLuint
+{
+  if (m_Created.empty()) {
+    m_Created.resize(m_BatchSize);
+    auto const Count = static_cast<GLsizei>(m_BatchSize);
+    switch (m_Type) {
+    case ObjectType::Buffer:
+      glCreateBuffers(Count, m_Created.data());
+      break;
+    case ObjectType::VertexArray:
+      glCreateVertexArrays(Count, m_Created.data());
+      break;
+    case ObjectType::Texture:
+      glCreateTextures(m_TextureTarget, Count, m_Created.data());
+      break;
+    case ObjectType::Framebuffer:
+      glCreateFramebuffers(Count, m_Created.data());
+      break;
+    }
+  }
+  auto const Name = m_Created.back();
+  m_Created.pop_back();
+  return Name;
+}
+
+void renderer::gl::ObjectPool::Release(GLuint name)
+{
+  if (name == 0) { return; }
+  // Storage is immutable, so a released object cannot be handed out again;
+  // its name returns to the driver with the rest of the batch
+  m_Released.push_back(name);
+  if (m_Released.size() >= m_BatchSize) { Flush(); }
+}
+
+void renderer::gl::ObjectPool::Flush() noexcept
+{
+  Delete(m_Released);
+  m_Released.clear();
+}
+
+void renderer::gl::Buffer::Storage(GLsizeiptr size,
+  GLbitfield flags) const noexcept
+{
+  glNamedBufferStorage(GetName(), size, nullptr, flags);
+}
+
+void renderer::gl::Buffer::Storage(std::span<std::byte const> data,
+  GLbitfield flags) const noexcept
+{
+  glNamedBufferStorage(
+    GetName(), static_cast<GLsizeiptr>(data.size()), data.data(), flags);
+}
+
+void renderer::gl::Buffer::SubData(GLintptr offset,
+  std::span<std::byte const> data) const noexcept
+{
+  glNamedBufferSubData(
+    GetName(), offset, static_cast<GLsizeiptr>(data.size()), data.data());
+}
+
+auto renderer::gl::Buffer::GetSize() const noexcept -> GLsizeiptr
+{
+  GLint64 Size{};
+  glGetNamedBufferParameteri64v(GetName(), GL_BUFFER_SIZE, &Size);
+  return static_cast<GLsizeiptr>(Size);
+}
+
+void renderer::gl::VertexArray::SetVertexBuffer(GLuint binding_index,
+  Buffer const &buffer,
+  GLintptr offset,
+  GLsizei stride) const noexcept
+{
+  glVertexArrayVertexBuffer(
+    GetName(), binding_index, buffer.GetName(), offset, stride);
+}
+
+void renderer::gl::VertexArray::SetElementBuffer(
+  Buffer const &buffer) const noexcept
+{
+  glVertexArrayElementBuffer(GetName(), buffer.GetName());
+}
+
+void renderer::gl::VertexArray::Bind() const noexcept
+{
+  glBindVertexArray(GetName());
+}
+
+void renderer::gl::Texture::Storage1D(GLsizei levels,
+  GLenum internal_format,
+  GLsizei width) const noexcept
+{
+  glTextureStorage1D(GetName(), levels, internal_format, width);
+}
+
+void renderer::gl::Texture::Storage2D(GLsizei levels,
+  GLenum internal_format,
+  GLsizei width,
+  GLsizei height) const noexcept
+{
+  glTextureStorage2D(GetName(), levels, internal_format, width, height);
+}
+
+void renderer::gl::Texture::SubImage1D(GLint level,
+  GLint x,
+  GLsizei width,
+  GLenum format,
+  GLenum type,
+  void const *pixels) const noexcept
+{
+  glTextureSubImage1D(GetName(), level, x, width, format, type, pixels);
+}
+
+void renderer::gl::Texture::SubImage2D(GLint level,
+  GLint x,
+  GLint y,
+  GLsizei width,
+  GLsizei height,
+  GLenum format,
+  GLenum type,
+  void const *pixels) const noexcept
+{
+  glTextureSubImage2D(
+    GetName(), level, x, y, width, height, format, type, pixels);
+}
+
+void renderer::gl::Texture::SetParameter(GLenum parameter,
+  GLint value) const noexcept
+{
+  glTextureParameteri(GetName(), parameter, value);
+}
+
+void renderer::gl::Texture::Bind(GLuint unit) const noexcept
+{
+  glBindTextureUnit(unit, GetName());
+}
+
+void renderer::gl::Framebuffer::AttachTexture(GLenum attachment,
+  Texture const &texture,
+  GLint level) const noexcept
+{
+  glNamedFramebufferTexture(GetName(), attachment, texture.GetName(), level);
+}
+
+auto renderer::gl::Framebuffer::IsComplete() const noexcept -> bool
+{
+  return glCheckNamedFramebufferStatus(GetName(), GL_FRAMEBUFFER)
+         == GL_FRAMEBUFFER_COMPLETE;
+}
+
+void renderer::gl::Framebuffer::Bind(GLenum target) const noexcept
+{
+  glBindFramebuffer(target, GetName());
+}
@@ -0,0 +1,172 @@
+#include <renderer/point/markerRenderer.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <renderer/buffer/vertexLayout.hpp>
+#include <renderer/shader/shader.hpp>
+#include <renderer/vector/vector.hpp>
+#include <span>
+#include <string_view>
+#include <utility>
+
+namespace {
+constexpr std::string_view kMarkerVertexShader = R"glsl(#version 450 core
+layout(location = 0) in vec3 aCentre;
+layout(location = 1) in vec4 aColour;
+
+uniform vec4 uTransform;// xy scale, zw offset
+uniform vec2 uPixelSize;// one pixel in clip space
+uniform float uMarkerSize;// in pixels
+uniform int uShape;
+
+out vec4 vColour;
+out vec2 vCorner;
+
+// Two triangles covering [-1, 1] x [-1, 1]
+const vec2 kQuad[6] = vec2[](vec2(-1.0, -1.0), vec2(1.0, -1.0),
+  vec2(1.0, 1.0), vec2(-1.0, -1.0), vec2(1.0, 1.0), vec2(-1.0, 1.0));
+const int kCross = 1;
+const float kCrossThickness = 0.25;
+
+void main()
+{
+  vec2 Corner = kQuad[gl_VertexID % 6];
+  // A cross is a thin horizontal bar followed by the same bar turned upright
+  if (uShape == kCross) {
+    Corner.y *= kCrossThickness;
+    if (gl_VertexID >= 6) { Corner = vec2(-Corner.y, Corner.x); }
+  }
+  vColour = aColour;
+  vCorner = Corner;
+  vec2 Centre = aCentre.xy * uTransform.xy + uTransform.zw;
+  gl_Position = vec4(
+    Centre + Corner * (0.5 * uMarkerSize) * uPixelSize, aCentre.z, 1.0);
+}
+)glsl";
+
+constexpr std::string_view kMarkerFragmentShader = R"glsl(#version 450 core
+in vec4 vColour;
+in vec2 vCorner;
+
+uniform int uShape;
+
+out vec4 FragColour;
+
+const int kCircle = 0;
+
+void main()
+{
+  // Circles are cut out of their quad
+  if (uShape == kCircle && dot(vCorner, vCorner) > 1.0) { discard; }
+  FragColour = vColour;
+}
+)glsl";
+}// namespace
+
+renderer::gl::MarkerRenderer::MarkerRenderer()
+  : m_Program(ShaderUnit<GL_VERTEX_SHADER>(kMarkerVertexShader),
+      ShaderUnit<GL_FRAGMENT_SHADER>(kMarkerFragmentShader)),
+    m_TransformUniform(m_Program.GetUniformHandle("uTransform")),
+    m_PixelSizeUniform(m_Program.GetUniformHandle("uPixelSize")),
+    m_MarkerSizeUniform(m_Program.GetUniformHandle("uMarkerSize")),
+    m_ShapeUniform(m_Program.GetUniformHandle("uShape"))
+{
+  glCreateVertexArrays(1, &m_VertexArray);
+  SetTransform({ { 1.0F, 1.0F } }, { { 0.0F, 0.0F } });
+  std::array<GLint, 4> Viewport{};
+  glGetIntegerv(GL_VIEWPORT, Viewport.data());
+  SetViewport(Viewport[2], Viewport[3]);
+}
+
+renderer::gl::MarkerRenderer::MarkerRenderer(MarkerRenderer &&other) noexcept
+  : m_Program(std::move(other.m_Program)),
+    m_TransformUniform(other.m_TransformUniform),
+    m_PixelSizeUniform(other.m_PixelSizeUniform),
+    m_MarkerSizeUniform(other.m_MarkerSizeUniform),
+    m_ShapeUniform(other.m_ShapeUniform),
+    m_VertexArray(std::exchange(other.m_VertexArray, 0)),
+    m_Buffer(std::exchange(other.m_Buffer, 0)),
+    m_Capacity(std::exchange(other.m_Capacity, 0)),
+    m_InstanceCount(std::exchange(other.m_InstanceCount, 0))
+{}
+
+auto renderer::gl::MarkerRenderer::operator=(MarkerRenderer &&other) noexcept
+  -> MarkerRenderer &
+{
+  if (this != &other) {
+    Release();
+    m_Program = std::move(other.m_Program);
+    m_TransformUniform = other.m_TransformUniform;
+    m_PixelSizeUniform = other.m_PixelSizeUniform;
+    m_MarkerSizeUniform = other.m_MarkerSizeUniform;
+    m_ShapeUniform = other.m_ShapeUniform;
+    m_VertexArray = std::exchange(other.m_VertexArray, 0);
+    m_Buffer = std::exchange(other.m_Buffer, 0);
+    m_Capacity = std::exchange(other.m_Capacity, 0);
+    m_InstanceCount = std::exchange(other.m_InstanceCount, 0);
+  }
+  return *this;
+}
+
+void renderer::gl::MarkerRenderer::Release() noexcept
+{
+  glDeleteVertexArrays(1, &m_VertexArray);
+  glDeleteBuffers(1, &m_Buffer);
+  m_VertexArray = 0;
+  m_Buffer = 0;
+  m_Capacity = 0;
+}
+
+void renderer::gl::MarkerRenderer::SetInstances(GLuint buffer,
+  GLintptr offset,
+  GLsizei count,
+  std::span<VertexAttribute const> attributes,
+  GLsizei stride) noexcept
+{
+  SetupVertexArray(m_VertexArray,
+    buffer,
+    attributes,
+    stride,
+    { .Offset = offset, .Divisor = 1 });
+  m_InstanceCount = count;
+}
+
+void renderer::gl::MarkerRenderer::UploadInstances(
+  std::span<std::byte const> bytes,
+  GLsizei count,
+  std::span<VertexAttribute const> attributes,
+  GLsizei stride)
+{
+  UploadGrowing(m_Buffer, m_Capacity, bytes);
+  SetInstances(m_Buffer, 0, count, attributes, stride);
+}
+
+void renderer::gl::MarkerRenderer::SetTransform(
+  renderer::Vector2<float> scale,
+  renderer::Vector2<float> offset)
+{
+  m_Program.SetUniform<4, float>(
+    m_TransformUniform, scale.X(), scale.Y(), offset.X(), offset.Y());
+}
+
+void renderer::gl::MarkerRenderer::SetViewport(GLsizei width, GLsizei height)
+{
+  // Clip space spans two units across the framebuffer. An empty viewport
+  // counts as one pixel rather than making the markers infinitely large.
+  m_Program.SetUniform<2, float>(m_PixelSizeUniform,
+    2.0F / static_cast<float>(std::max(width, 1)),
+    2.0F / static_cast<float>(std::max(height, 1)));
+}
+
+void renderer::gl::MarkerRenderer::Draw(MarkerStyle style)
+{
+  if (m_InstanceCount == 0) { return; }
+  m_Program.SetUniform<1, float>(m_MarkerSizeUniform, style.Size);
+  m_Program.SetUniform<1, int>(
+    m_ShapeUniform, static_cast<int>(style.Shape));
+  m_Program.Use();
+  glBindVertexArray(m_VertexArray);
+  glDrawArraysInstanced(
+    GL_TRIANGLES, 0, GetMarkerVertexCount(style.Shape), m_InstanceCount);
+}
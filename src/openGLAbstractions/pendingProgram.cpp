@@ -0,0 +1,115 @@
+#include <renderer/shader/pendingProgram.hpp>
+// NOLINTNEXTLINE
+#include <GLFW/glfw3.h>
+#include <renderer/error/error.hpp>
+#include <renderer/shader/shader.hpp>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace {
+using MaxShaderCompilerThreadsProc = void(GLAPIENTRY *)(GLuint);
+}// namespace
+
+auto renderer::gl::SupportsParallelShaderCompile() -> bool
+{
+  // Asked afresh every time: it is cheap next to the compile it decides
+  // about, and a cache could not tell a re-created context from the old one
+  return glfwExtensionSupported("GL_KHR_parallel_shader_compile") == GLFW_TRUE
+         || glfwExtensionSupported("GL_ARB_parallel_shader_compile")
+              == GLFW_TRUE;
+}
+
+auto renderer::gl::SetMaxShaderCompilerThreads(GLADloadproc load_proc,
+  GLuint count) -> bool
+{
+  if (!SupportsParallelShaderCompile()) { return false; }
+  void *Proc = load_proc("glMaxShaderCompilerThreadsKHR");
+  if (Proc == nullptr) { Proc = load_proc("glMaxShaderCompilerThreadsARB"); }
+  if (Proc == nullptr) { return false; }
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  reinterpret_cast<MaxShaderCompilerThreadsProc>(Proc)(count);
+  return true;
+}
+
+renderer::gl::PendingProgram::PendingProgram(
+  std::span<ShaderSource const> sources)
+  : m_ProgramID(glCreateProgram()), m_CanPoll(SupportsParallelShaderCompile())
+{
+  m_ShaderIDs.reserve(sources.size());
+  for (auto const &[Type, Source] : sources) {
+    auto const Shader = glCreateShader(Type);
+    auto const *Text = Source.data();
+    auto const Length = static_cast<GLint>(Source.size());
+    glShaderSource(Shader, 1, &Text, &Length);
+    glCompileShader(Shader);
+    glAttachShader(m_ProgramID, Shader);
+    m_ShaderIDs.push_back(Shader);
+  }
+  // Linking straight away queues it behind the compiles instead of waiting
+  glProgramParameteri(
+    m_ProgramID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+  glLinkProgram(m_ProgramID);
+}
+
+renderer::gl::PendingProgram::PendingProgram(PendingProgram &&other) noexcept
+  : m_ProgramID(std::exchange(other.m_ProgramID, 0)),
+    m_ShaderIDs(std::move(other.m_ShaderIDs)),
+    m_CanPoll(other.m_CanPoll)
+{}
+
+auto renderer::gl::PendingProgram::operator=(PendingProgram &&other) noexcept
+  -> PendingProgram &
+{
+  if (this != &other) {
+    Release();
+    m_ProgramID = std::exchange(other.m_ProgramID, 0);
+    m_ShaderIDs = std::move(other.m_ShaderIDs);
+    m_CanPoll = other.m_CanPoll;
+  }
+  return *this;
+}
+
+void renderer::gl::PendingProgram::Release() noexcept
+{
+  for (auto const Shader : m_ShaderIDs) { glDeleteShader(Shader); }
+  m_ShaderIDs.clear();
+  glDeleteProgram(std::exchange(m_ProgramID, 0));
+}
+
+auto renderer::gl::PendingProgram::IsReady() const noexcept -> bool
+{
+  if (!m_CanPoll || m_ProgramID == 0) { return true; }
+  GLint Completed{};
+  glGetProgramiv(m_ProgramID, kCompletionStatusKHR, &Completed);
+  return Completed == GL_TRUE;
+}
+
+auto renderer::gl::PendingProgram::Get() -> Program
+{
+  if (m_ProgramID == 0) {
+    throw renderer::CompilationError("PendingProgram has already been taken");
+  }
+  GLint ProgramLinked{};
+  glGetProgramiv(m_ProgramID, GL_LINK_STATUS, &ProgramLinked);
+  if (ProgramLinked != GL_TRUE) {
+    // Report the first unit that failed, as the link log rarely says why
+    auto Message = GetProgramInfoLog(m_ProgramID);
+    for (auto const Shader : m_ShaderIDs) {
+      GLint Compiled{};
+      glGetShaderiv(Shader, GL_COMPILE_STATUS, &Compiled);
+      if (Compiled != GL_TRUE) {
+        Message = GetShaderInfoLog(Shader);
+        break;
+      }
+    }
+    Release();
+    throw renderer::CompilationError(std::move(Message));
+  }
+  for (auto const Shader : m_ShaderIDs) {
+    glDetachShader(m_ProgramID, Shader);
+    glDeleteShader(Shader);
+  }
+  m_ShaderIDs.clear();
+  return Program::AdoptLinked(std::exchange(m_ProgramID, 0));
+}
@@ -0,0 +1,51 @@
+#include <renderer/shape/polygonBatch.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <renderer/buffer/vertexLayout.hpp>
+#include <renderer/drawer/openGlDrawer.hpp>
+#include <renderer/shader/shader.hpp>
+#include <span>
+
+renderer::gl::PolygonRenderer::PolygonRenderer()
+{
+  glCreateVertexArrays(1, &m_VertexArray);
+}
+
+renderer::gl::PolygonRenderer::~PolygonRenderer()
+{
+  glDeleteVertexArrays(1, &m_VertexArray);
+  glDeleteBuffers(1, &m_VertexBuffer);
+  glDeleteBuffers(1, &m_IndexBuffer);
+}
+
+void renderer::gl::PolygonRenderer::UploadBuffers(
+  std::span<std::byte const> vertices,
+  std::span<VertexAttribute const> attributes,
+  GLsizei stride,
+  std::span<GLuint const> indices)
+{
+  UploadGrowing(m_VertexBuffer, m_VertexCapacity, vertices);
+  SetupVertexArray(m_VertexArray, m_VertexBuffer, attributes, stride);
+  UploadGrowing(m_IndexBuffer, m_IndexCapacity, std::as_bytes(indices));
+  glVertexArrayElementBuffer(m_VertexArray, m_IndexBuffer);
+  m_IndexCount = static_cast<GLsizei>(indices.size());
+}
+
+void renderer::gl::PolygonRenderer::Draw() const noexcept
+{
+  if (m_IndexCount == 0) { return; }
+  glBindVertexArray(m_VertexArray);
+  glDrawElements(GL_TRIANGLES, m_IndexCount, GL_UNSIGNED_INT, nullptr);
+}
+
+auto renderer::gl::PolygonRenderer::MakeDrawer(Program const &program) const
+  -> OpenGLDrawer
+{
+  return OpenGLDrawer(
+    [this, &program](GLFWwindow const & /*window*/,
+      std::chrono::nanoseconds /*delta_time*/) {
+      program.Use();
+      Draw();
+    });
+}
@@ -0,0 +1,90 @@
+#include <renderer/plot/polylineBatch.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <renderer/buffer/vertexLayout.hpp>
+#include <renderer/drawer/openGlDrawer.hpp>
+#include <renderer/shader/shader.hpp>
+#include <span>
+
+renderer::gl::PolylineRenderer::PolylineRenderer()
+  : PolylineRenderer(GLAD_GL_VERSION_4_3 != 0
+                       ? PolylineSubmission::MultiDrawIndirect
+                       : PolylineSubmission::PrimitiveRestart)
+{}
+
+renderer::gl::PolylineRenderer::PolylineRenderer(
+  PolylineSubmission submission)
+  : m_Submission(submission)
+{
+  if (GLAD_GL_VERSION_4_5 != 0) {
+    glCreateVertexArrays(1, &m_VertexArray);
+  } else {
+    glGenVertexArrays(1, &m_VertexArray);
+  }
+}
+
+renderer::gl::PolylineRenderer::~PolylineRenderer()
+{
+  glDeleteVertexArrays(1, &m_VertexArray);
+  glDeleteBuffers(1, &m_VertexBuffer);
+  glDeleteBuffers(1, &m_DrawBuffer);
+}
+
+void renderer::gl::PolylineRenderer::UploadVertices(
+  std::span<std::byte const> bytes,
+  std::span<VertexAttribute const> attributes,
+  GLsizei stride)
+{
+  UploadGrowing(m_VertexBuffer, m_VertexCapacity, bytes);
+  SetupVertexArray(m_VertexArray, m_VertexBuffer, attributes, stride);
+}
+
+void renderer::gl::PolylineRenderer::UploadCommands(
+  std::span<DrawArraysIndirectCommand const> commands)
+{
+  UploadGrowing(m_DrawBuffer, m_DrawCapacity, std::as_bytes(commands));
+  m_DrawCount = static_cast<GLsizei>(commands.size());
+}
+
+void renderer::gl::PolylineRenderer::UploadIndices(
+  std::span<GLuint const> indices)
+{
+  UploadGrowing(m_DrawBuffer, m_DrawCapacity, std::as_bytes(indices));
+  if (GLAD_GL_VERSION_4_5 != 0) {
+    glVertexArrayElementBuffer(m_VertexArray, m_DrawBuffer);
+  } else {
+    // The element buffer binding is part of the bound vertex array
+    glBindVertexArray(m_VertexArray);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_DrawBuffer);
+    glBindVertexArray(0);
+  }
+  m_DrawCount = static_cast<GLsizei>(indices.size());
+}
+
+void renderer::gl::PolylineRenderer::Draw() const noexcept
+{
+  if (m_DrawCount == 0) { return; }
+  glBindVertexArray(m_VertexArray);
+  if (m_Submission == PolylineSubmission::MultiDrawIndirect) {
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_DrawBuffer);
+    glMultiDrawArraysIndirect(GL_LINE_STRIP, nullptr, m_DrawCount, 0);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+    return;
+  }
+  glEnable(GL_PRIMITIVE_RESTART);
+  glPrimitiveRestartIndex(kPrimitiveRestartIndex);
+  glDrawElements(GL_LINE_STRIP, m_DrawCount, GL_UNSIGNED_INT, nullptr);
+  glDisable(GL_PRIMITIVE_RESTART);
+}
+
+auto renderer::gl::PolylineRenderer::MakeDrawer(Program const &program) const
+  -> OpenGLDrawer
+{
+  return OpenGLDrawer(
+    [this, &program](GLFWwindow const & /*window*/,
+      std::chrono::nanoseconds /*delta_time*/) {
+      program.Use();
+      Draw();
+    });
+}
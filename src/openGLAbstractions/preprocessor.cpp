@@ -0,0 +1,180 @@
+#include <renderer/shader/preprocessor.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <fmt/format.h>
+#include <initializer_list>
+#include <iterator>
+#include <renderer/error/error.hpp>
+#include <renderer/utils/hash.hpp>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace {
+constexpr std::string_view kWhitespace = " \t\r";
+
+auto TrimLeft(std::string_view text) noexcept -> std::string_view
+{
+  auto const Start = text.find_first_not_of(kWhitespace);
+  return Start == std::string_view::npos ? std::string_view{}
+                                         : text.substr(Start);
+}
+
+// Returns what follows "#directive" on line, or nothing if line is not that
+// directive
+auto MatchDirective(std::string_view line, std::string_view directive)
+  -> std::optional<std::string_view>
+{
+  line = TrimLeft(line);
+  if (!line.starts_with('#')) { return std::nullopt; }
+  line = TrimLeft(line.substr(1));
+  if (!line.starts_with(directive)) { return std::nullopt; }
+  auto Rest = line.substr(directive.size());
+  if (!Rest.empty() && kWhitespace.find(Rest.front()) == std::string_view::npos
+      && Rest.front() != '"') {
+    return std::nullopt;
+  }
+  return TrimLeft(Rest);
+}
+
+class Preprocessor
+{
+  renderer::gl::IncludeResolver const &m_Resolve;
+  std::vector<std::string> m_Included{};
+  std::vector<std::string> m_Stack{};
+  std::string m_Output{};
+
+public:
+  explicit Preprocessor(renderer::gl::IncludeResolver const &resolve)
+    : m_Resolve(resolve)
+  {}
+
+  auto TakeOutput() noexcept -> std::string { return std::move(m_Output); }
+
+  void Append(std::string_view text)
+  {
+    m_Output.append(text);
+    m_Output.push_back('\n');
+  }
+
+  // Copies source from line number first_line onwards, expanding includes
+  void Expand(std::string_view source,
+    std::size_t source_number,
+    std::size_t first_line)
+  {
+    std::size_t LineNumber = first_line;
+    while (!source.empty()) {
+      auto const End = source.find('\n');
+      auto const Line = source.substr(0, End);
+      source = End == std::string_view::npos ? std::string_view{}
+                                             : source.substr(End + 1);
+      auto const Included = MatchDirective(Line, "include");
+      if (!Included.has_value()) {
+        Append(Line);
+        ++LineNumber;
+        continue;
+      }
+      ExpandInclude(*Included);
+      ++LineNumber;
+      Append(fmt::format("#line {} {}", LineNumber, source_number));
+    }
+  }
+
+  void ExpandInclude(std::string_view directive)
+  {
+    auto const Close = directive.find('"', 1);
+    if (!directive.starts_with('"') || Close == std::string_view::npos) {
+      throw renderer::CompilationError(
+        fmt::format("Malformed #include {}", directive));
+    }
+    std::string Name(directive.substr(1, Close - 1));
+    if (std::ranges::find(m_Stack, Name) != m_Stack.end()) {
+      throw renderer::CompilationError(
+        fmt::format("\"{}\" includes itself", Name));
+    }
+    // Like #pragma once: a file included twice is expanded the first time
+    if (std::ranges::find(m_Included, Name) != m_Included.end()) { return; }
+    auto Source =
+      m_Resolve ? m_Resolve(Name) : std::optional<std::string>{};
+    if (!Source.has_value()) {
+      throw renderer::CompilationError(
+        fmt::format("Cannot find included shader \"{}\"", Name));
+    }
+    m_Included.push_back(Name);
+    auto const SourceNumber = m_Included.size();
+    m_Stack.push_back(std::move(Name));
+    Append(fmt::format("#line 1 {}", SourceNumber));
+    Expand(*Source, SourceNumber, 1);
+    m_Stack.pop_back();
+  }
+};
+}// namespace
+
+renderer::gl::ShaderDefines::ShaderDefines(
+  std::initializer_list<ShaderDefine> defines)
+{
+  for (auto const &Define : defines) { Set(Define.Name, Define.Value); }
+}
+
+void renderer::gl::ShaderDefines::UpdateKey() noexcept
+{
+  m_Key = utils::kFnv1aOffsetBasis;
+  for (auto const &[Name, Value] : m_Defines) {
+    m_Key = utils::Fnv1a(Name.size(), m_Key);
+    m_Key = utils::Fnv1a(Name, m_Key);
+    m_Key = utils::Fnv1a(Value.size(), m_Key);
+    m_Key = utils::Fnv1a(Value, m_Key);
+  }
+}
+
+auto renderer::gl::ShaderDefines::Set(std::string_view name,
+  std::string_view value) -> ShaderDefines &
+{
+  auto Position =
+    std::ranges::lower_bound(m_Defines, name, {}, &ShaderDefine::Name);
+  if (Position != m_Defines.end() && Position->Name == name) {
+    Position->Value = value;
+  } else {
+    m_Defines.insert(
+      Position, ShaderDefine{ std::string(name), std::string(value) });
+  }
+  UpdateKey();
+  return *this;
+}
+
+auto renderer::gl::ShaderDefines::Unset(std::string_view name)
+  -> ShaderDefines &
+{
+  std::erase_if(
+    m_Defines, [&](ShaderDefine const &define) { return define.Name == name; });
+  UpdateKey();
+  return *this;
+}
+
+auto renderer::gl::PreprocessShader(std::string_view source,
+  ShaderDefines const &defines,
+  IncludeResolver const &resolve) -> std::string
+{
+  Preprocessor Processor(resolve);
+  // GLSL only allows comments and whitespace before #version, so the defines
+  // follow it
+  std::size_t FirstLine = 1;
+  for (std::size_t Start = 0, Line = 1; Start < source.size(); ++Line) {
+    auto const End = std::min(source.find('\n', Start), source.size());
+    if (MatchDirective(source.substr(Start, End - Start), "version")) {
+      Processor.Append(source.substr(0, End));
+      source = source.substr(std::min(End + 1, source.size()));
+      FirstLine = Line + 1;
+      break;
+    }
+    Start = End + 1;
+  }
+  for (auto const &[Name, Value] : defines.Get()) {
+    Processor.Append(fmt::format("#define {} {}", Name, Value));
+  }
+  Processor.Append(fmt::format("#line {} 0", FirstLine));
+  Processor.Expand(source, 0, FirstLine);
+  return Processor.TakeOutput();
+}
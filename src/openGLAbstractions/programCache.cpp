@@ -0,0 +1,165 @@
+#include <renderer/shader/programCache.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fmt/format.h>
+#include <fstream>
+#include <initializer_list>
+#include <ios>
+#include <optional>
+#include <renderer/shader/shader.hpp>
+#include <renderer/utils/hash.hpp>
+#include <spdlog/spdlog.h>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace {
+// "BPHOPRG" followed by the file format version
+constexpr std::uint64_t kCacheMagic = 0x01'47'52'50'4F'48'50'42ULL;
+
+struct EntryHeader
+{
+  std::uint64_t Magic;
+  std::uint64_t Key;
+  std::uint32_t Format;
+  std::uint32_t Size;
+};
+
+auto GetGLString(GLenum name) -> std::string_view
+{
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  auto const *String = reinterpret_cast<char const *>(glGetString(name));
+  return String == nullptr ? std::string_view{} : std::string_view{ String };
+}
+}// namespace
+
+renderer::gl::ProgramBinaryCache::ProgramBinaryCache(
+  std::filesystem::path directory)
+  : m_Directory(std::move(directory))
+{
+  GLint FormatCount{};
+  glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &FormatCount);
+  m_Enabled = FormatCount > 0;
+  for (auto const Name : { GL_VENDOR, GL_RENDERER, GL_VERSION }) {
+    auto const Value = GetGLString(Name);
+    m_DriverHash = utils::Fnv1a(Value.size(), m_DriverHash);
+    m_DriverHash = utils::Fnv1a(Value, m_DriverHash);
+  }
+}
+
+auto renderer::gl::ProgramBinaryCache::GetEntryPath(std::uint64_t key) const
+  -> std::filesystem::path
+{
+  return m_Directory / fmt::format("{:016x}.bin", key);
+}
+
+auto renderer::gl::ProgramBinaryCache::GetKey(
+  std::initializer_list<std::string_view> sources) const noexcept
+  -> std::uint64_t
+{
+  auto Key = m_DriverHash;
+  for (auto const Source : sources) {
+    Key = utils::Fnv1a(Source.size(), Key);
+    Key = utils::Fnv1a(Source, Key);
+  }
+  return Key;
+}
+
+auto renderer::gl::ProgramBinaryCache::Load(std::uint64_t key) const
+  -> std::optional<Program>
+{
+  if (!m_Enabled) { return std::nullopt; }
+  auto const Path = GetEntryPath(key);
+  std::ifstream File(Path, std::ios::binary);
+  if (!File) { return std::nullopt; }
+
+  EntryHeader Header{};
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  File.read(reinterpret_cast<char *>(&Header), sizeof(Header));
+  // The header is checked against the file before anything is allocated, so
+  // a corrupt or foreign file cannot ask for a huge buffer
+  std::error_code SizeError;
+  auto const FileSize = std::filesystem::file_size(Path, SizeError);
+  if (File && !SizeError && Header.Magic == kCacheMagic && Header.Key == key
+      && Header.Size <= FileSize - sizeof(Header)) {
+    ProgramBinary Binary{ .Format = Header.Format,
+      .Data = std::vector<std::byte>(Header.Size) };
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    File.read(reinterpret_cast<char *>(Binary.Data.data()),
+      static_cast<std::streamsize>(Binary.Data.size()));
+    if (File) {
+      if (auto Loaded = Program::FromBinary(Binary)) { return Loaded; }
+    }
+  }
+  spdlog::info("Discarding stale program binary {}", Path.string());
+  File.close();
+  std::error_code Ignored;
+  std::filesystem::remove(Path, Ignored);
+  return std::nullopt;
+}
+
+void renderer::gl::ProgramBinaryCache::Store(std::uint64_t key,
+  Program const &program) const
+{
+  if (!m_Enabled) { return; }
+  auto const Binary = program.GetBinary();
+  if (!Binary.has_value()) { return; }
+
+  std::error_code Error;
+  std::filesystem::create_directories(m_Directory, Error);
+  auto const Path = GetEntryPath(key);
+  auto TemporaryPath = Path;
+  TemporaryPath += ".tmp";
+  {
+    std::ofstream File(TemporaryPath, std::ios::binary | std::ios::trunc);
+    EntryHeader const Header{ .Magic = kCacheMagic,
+      .Key = key,
+      .Format = Binary->Format,
+      .Size = static_cast<std::uint32_t>(Binary->Data.size()) };
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    File.write(reinterpret_cast<char const *>(&Header), sizeof(Header));
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    File.write(reinterpret_cast<char const *>(Binary->Data.data()),
+      static_cast<std::streamsize>(Binary->Data.size()));
+    if (!File) {
+      spdlog::warn("Could not write program binary {}", Path.string());
+      return;
+    }
+  }
+  // Renaming keeps concurrent runs from reading a half-written entry
+  std::filesystem::rename(TemporaryPath, Path, Error);
+  if (Error) {
+    spdlog::warn(
+      "Could not store program binary {}: {}", Path.string(), Error.message());
+  }
+}
+
+auto renderer::gl::GetUserCacheDirectory(std::string_view application)
+  -> std::filesystem::path
+{
+  auto const FromEnvironment =
+    [](char const *name) -> std::optional<std::filesystem::path> {
+    // NOLINTNEXTLINE(concurrency-mt-unsafe)
+    auto const *Value = std::getenv(name);
+    if (Value == nullptr || *Value == '\0') { return std::nullopt; }
+    return std::filesystem::path(Value);
+  };
+#ifdef _WIN32
+  auto Base = FromEnvironment("LOCALAPPDATA");
+#else
+  auto Base = FromEnvironment("XDG_CACHE_HOME");
+  if (!Base.has_value()) {
+    if (auto Home = FromEnvironment("HOME")) { Base = *Home / ".cache"; }
+  }
+#endif
+  if (!Base.has_value()) {
+    std::error_code Error;
+    Base = std::filesystem::temp_directory_path(Error);
+  }
+  return *Base / application;
+}
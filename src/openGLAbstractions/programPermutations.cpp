@@ -0,0 +1,75 @@
+#include <renderer/shader/programPermutations.hpp>
+
+#include <initializer_list>
+#include <renderer/error/error.hpp>
+#include <renderer/shader/pendingProgram.hpp>
+#include <renderer/shader/preprocessor.hpp>
+#include <renderer/shader/shader.hpp>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+renderer::gl::ProgramPermutations::ProgramPermutations(
+  std::initializer_list<ShaderSource> units,
+  IncludeResolver resolve)
+  : m_Resolve(std::move(resolve))
+{
+  m_Units.reserve(units.size());
+  for (auto const &[Type, Source] : units) {
+    m_Units.push_back(Unit{ Type, std::string(Source) });
+  }
+}
+
+auto renderer::gl::ProgramPermutations::Find(ShaderDefines const &defines)
+  -> Permutation &
+{
+  auto [Position, Inserted] = m_Permutations.try_emplace(defines);
+  if (!Inserted) { return Position->second; }
+  try {
+    std::vector<std::string> Processed;
+    std::vector<ShaderSource> Sources;
+    Processed.reserve(m_Units.size());
+    Sources.reserve(m_Units.size());
+    for (auto const &[Type, Source] : m_Units) {
+      Processed.push_back(PreprocessShader(Source, defines, m_Resolve));
+      Sources.push_back(ShaderSource{ Type, Processed.back() });
+    }
+    Position->second.Pending.emplace(std::span<ShaderSource const>(Sources));
+  } catch (...) {
+    m_Permutations.erase(Position);
+    throw;
+  }
+  return Position->second;
+}
+
+auto renderer::gl::ProgramPermutations::Finish(ShaderDefines const &defines,
+  Permutation &permutation) -> Program &
+{
+  if (permutation.Pending.has_value()) {
+    try {
+      permutation.Built = permutation.Pending->Get();
+    } catch (renderer::CompilationError const &) {
+      m_Permutations.erase(defines);
+      throw;
+    }
+    permutation.Pending.reset();
+  }
+  return *permutation.Built;
+}
+
+auto renderer::gl::ProgramPermutations::Get(ShaderDefines const &defines)
+  -> Program &
+{
+  return Finish(defines, Find(defines));
+}
+
+auto renderer::gl::ProgramPermutations::TryGet(ShaderDefines const &defines)
+  -> Program *
+{
+  auto &Found = Find(defines);
+  if (Found.Pending.has_value() && !Found.Pending->IsReady()) {
+    return nullptr;
+  }
+  return &Finish(defines, Found);
+}
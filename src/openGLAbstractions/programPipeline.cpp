@@ -0,0 +1,61 @@
+#include <renderer/shader/programPipeline.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <renderer/error/error.hpp>
+#include <renderer/shader/shader.hpp>
+#include <string>
+
+auto renderer::gl::StageProgram::GetStageBit() const noexcept -> GLbitfield
+{
+  switch (m_ShaderType) {
+  case GL_VERTEX_SHADER:
+    return GL_VERTEX_SHADER_BIT;
+  case GL_TESS_CONTROL_SHADER:
+    return GL_TESS_CONTROL_SHADER_BIT;
+  case GL_TESS_EVALUATION_SHADER:
+    return GL_TESS_EVALUATION_SHADER_BIT;
+  case GL_GEOMETRY_SHADER:
+    return GL_GEOMETRY_SHADER_BIT;
+  case GL_FRAGMENT_SHADER:
+    return GL_FRAGMENT_SHADER_BIT;
+  default:
+    return GL_COMPUTE_SHADER_BIT;
+  }
+}
+
+auto renderer::gl::GetPipelineStageIndex(GLenum shader_type) -> std::size_t
+{
+  switch (shader_type) {
+  case GL_VERTEX_SHADER:
+    return 0;
+  case GL_TESS_CONTROL_SHADER:
+    return 1;
+  case GL_TESS_EVALUATION_SHADER:
+    return 2;
+  case GL_GEOMETRY_SHADER:
+    return 3;
+  case GL_FRAGMENT_SHADER:
+    return 4;
+  default:
+    return 5;
+  }
+}
+
+void renderer::gl::ProgramPipeline::Validate() const
+{
+  glValidateProgramPipeline(m_PipelineID);
+  GLint Valid{};
+  glGetProgramPipelineiv(m_PipelineID, GL_VALIDATE_STATUS, &Valid);
+  if (Valid == GL_TRUE) { return; }
+  GLint LogLength{};
+  glGetProgramPipelineiv(m_PipelineID, GL_INFO_LOG_LENGTH, &LogLength);
+  std::string Message(static_cast<std::size_t>(std::max(LogLength, 1)), '\0');
+  GLsizei Written{};
+  glGetProgramPipelineInfoLog(m_PipelineID,
+    static_cast<GLsizei>(Message.size()),
+    &Written,
+    Message.data());
+  Message.resize(static_cast<std::size_t>(Written));
+  throw renderer::CompilationError(std::move(Message));
+}
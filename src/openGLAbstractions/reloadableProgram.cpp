@@ -0,0 +1,60 @@
+#include <renderer/shader/reloadableProgram.hpp>
+
+#include <algorithm>
+#include <optional>
+#include <renderer/error/error.hpp>
+#include <renderer/shader/pendingProgram.hpp>
+#include <renderer/shader/shader.hpp>
+#include <renderer/utils/fileWatcher.hpp>
+#include <span>
+#include <spdlog/spdlog.h>
+#include <utility>
+#include <vector>
+
+renderer::gl::ReloadableProgram::ReloadableProgram(
+  std::vector<ShaderFile> files,
+  std::optional<Program> built)
+  : m_Files(std::move(files)), m_Program(std::move(built))
+{
+  if (!m_Program.has_value()) { StartBuild(); }
+}
+
+void renderer::gl::ReloadableProgram::StartBuild()
+{
+  // PendingProgram compiles from views, so keep the sources alive in m_Files
+  std::vector<ShaderSource> Sources;
+  Sources.reserve(m_Files.size());
+  for (auto const &File : m_Files) {
+    Sources.push_back(ShaderSource{ File.Type, File.Source });
+  }
+  m_Pending.emplace(std::span<ShaderSource const>(Sources));
+}
+
+auto renderer::gl::ReloadableProgram::Update(
+  std::span<utils::ChangedFile const> changes) -> bool
+{
+  bool SourcesChanged = false;
+  for (auto const &Change : changes) {
+    auto File = std::ranges::find_if(m_Files, [&](ShaderFile const &file) {
+      return file.Path.lexically_normal() == Change.Path.lexically_normal();
+    });
+    if (File != m_Files.end() && File->Source != Change.Contents) {
+      File->Source = Change.Contents;
+      SourcesChanged = true;
+    }
+  }
+  // Restarting drops a rebuild of sources that are already out of date
+  if (SourcesChanged) { StartBuild(); }
+
+  if (!m_Pending.has_value() || !m_Pending->IsReady()) { return false; }
+  auto Pending = std::move(*m_Pending);
+  m_Pending.reset();
+  try {
+    m_Program = Pending.Get();
+  } catch (renderer::CompilationError const &Error) {
+    spdlog::error("Shader rebuild failed, keeping the previous program: {}",
+      Error.what());
+    return false;
+  }
+  return true;
+}
@@ -0,0 +1,335 @@
+#include <renderer/shader/shader.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <fmt/format.h>
+#include <iterator>
+#include <optional>
+#include <renderer/error/error.hpp>
+#include <renderer/utils/frameStatistics.hpp>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace {
+constexpr std::string_view kArraySuffix = "[0]";
+
+auto TrimArraySuffix(std::string_view name) noexcept -> std::string_view
+{
+  if (name.ends_with(kArraySuffix)) {
+    name.remove_suffix(kArraySuffix.size());
+  }
+  return name;
+}
+
+struct UniformTypeShape
+{
+  GLenum ComponentType;
+  std::size_t Size;
+};
+
+// Component type and vector width for the non-opaque uniform types
+auto GetUniformTypeShape(GLenum type) noexcept
+  -> std::optional<UniformTypeShape>
+{
+  switch (type) {
+  case GL_FLOAT:
+    return UniformTypeShape{ GL_FLOAT, 1 };
+  case GL_FLOAT_VEC2:
+    return UniformTypeShape{ GL_FLOAT, 2 };
+  case GL_FLOAT_VEC3:
+    return UniformTypeShape{ GL_FLOAT, 3 };
+  case GL_FLOAT_VEC4:
+    return UniformTypeShape{ GL_FLOAT, 4 };
+  case GL_INT:
+    return UniformTypeShape{ GL_INT, 1 };
+  case GL_INT_VEC2:
+    return UniformTypeShape{ GL_INT, 2 };
+  case GL_INT_VEC3:
+    return UniformTypeShape{ GL_INT, 3 };
+  case GL_INT_VEC4:
+    return UniformTypeShape{ GL_INT, 4 };
+  case GL_UNSIGNED_INT:
+    return UniformTypeShape{ GL_UNSIGNED_INT, 1 };
+  case GL_UNSIGNED_INT_VEC2:
+    return UniformTypeShape{ GL_UNSIGNED_INT, 2 };
+  case GL_UNSIGNED_INT_VEC3:
+    return UniformTypeShape{ GL_UNSIGNED_INT, 3 };
+  case GL_UNSIGNED_INT_VEC4:
+    return UniformTypeShape{ GL_UNSIGNED_INT, 4 };
+  case GL_DOUBLE:
+    return UniformTypeShape{ GL_DOUBLE, 1 };
+  case GL_DOUBLE_VEC2:
+    return UniformTypeShape{ GL_DOUBLE, 2 };
+  case GL_DOUBLE_VEC3:
+    return UniformTypeShape{ GL_DOUBLE, 3 };
+  case GL_DOUBLE_VEC4:
+    return UniformTypeShape{ GL_DOUBLE, 4 };
+  case GL_BOOL:
+    return UniformTypeShape{ GL_BOOL, 1 };
+  case GL_BOOL_VEC2:
+    return UniformTypeShape{ GL_BOOL, 2 };
+  case GL_BOOL_VEC3:
+    return UniformTypeShape{ GL_BOOL, 3 };
+  case GL_BOOL_VEC4:
+    return UniformTypeShape{ GL_BOOL, 4 };
+  default:
+    return std::nullopt;
+  }
+}
+}// namespace
+
+auto renderer::gl::GetShaderInfoLog(GLuint shader_id) -> std::string
+{
+  GLint LogLength{};
+  glGetShaderiv(shader_id, GL_INFO_LOG_LENGTH, &LogLength);
+  std::string Message(static_cast<std::size_t>(std::max(LogLength, 1)), '\0');
+  GLsizei Written{};
+  glGetShaderInfoLog(
+    shader_id, static_cast<GLsizei>(Message.size()), &Written, Message.data());
+  Message.resize(static_cast<std::size_t>(Written));
+  return Message;
+}
+auto renderer::gl::GetProgramInfoLog(GLuint program_id) -> std::string
+{
+  GLint LogLength{};
+  glGetProgramiv(program_id, GL_INFO_LOG_LENGTH, &LogLength);
+  std::string Message(static_cast<std::size_t>(std::max(LogLength, 1)), '\0');
+  GLsizei Written{};
+  glGetProgramInfoLog(
+    program_id, static_cast<GLsizei>(Message.size()), &Written, Message.data());
+  Message.resize(static_cast<std::size_t>(Written));
+  return Message;
+}
+
+auto renderer::gl::IsUniformTypeCompatible(GLenum declared_type,
+  GLenum component_type,
+  std::size_t size) noexcept -> bool
+{
+  auto const Shape = GetUniformTypeShape(declared_type);
+  if (!Shape.has_value()) {
+    // Samplers and images are opaque and set as a single int (texture unit)
+    return component_type == GL_INT && size == 1;
+  }
+  if (Shape->Size != size) { return false; }
+  // Booleans may be set through any of the non-double setters
+  if (Shape->ComponentType == GL_BOOL) { return component_type != GL_DOUBLE; }
+  return Shape->ComponentType == component_type;
+}
+
+auto renderer::gl::GetUniformTypeString(GLenum type) -> char const *
+{
+  switch (type) {
+  case GL_FLOAT:
+    return "float";
+  case GL_FLOAT_VEC2:
+    return "vec2";
+  case GL_FLOAT_VEC3:
+    return "vec3";
+  case GL_FLOAT_VEC4:
+    return "vec4";
+  case GL_INT:
+    return "int";
+  case GL_INT_VEC2:
+    return "ivec2";
+  case GL_INT_VEC3:
+    return "ivec3";
+  case GL_INT_VEC4:
+    return "ivec4";
+  case GL_UNSIGNED_INT:
+    return "uint";
+  case GL_UNSIGNED_INT_VEC2:
+    return "uvec2";
+  case GL_UNSIGNED_INT_VEC3:
+    return "uvec3";
+  case GL_UNSIGNED_INT_VEC4:
+    return "uvec4";
+  case GL_DOUBLE:
+    return "double";
+  case GL_DOUBLE_VEC2:
+    return "dvec2";
+  case GL_DOUBLE_VEC3:
+    return "dvec3";
+  case GL_DOUBLE_VEC4:
+    return "dvec4";
+  case GL_BOOL:
+    return "bool";
+  case GL_BOOL_VEC2:
+    return "bvec2";
+  case GL_BOOL_VEC3:
+    return "bvec3";
+  case GL_BOOL_VEC4:
+    return "bvec4";
+  default:
+    return "Unknown";
+  }
+}
+
+void renderer::gl::Program::Link()
+{
+  // Lets GetBinary work on drivers that only keep binaries when asked to
+  glProgramParameteri(
+    m_ProgramID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+  glLinkProgram(m_ProgramID);
+  GLint ProgramLinked{};
+  glGetProgramiv(m_ProgramID, GL_LINK_STATUS, &ProgramLinked);
+  if (ProgramLinked != GL_TRUE) {
+    auto Message = GetProgramInfoLog(m_ProgramID);
+    glDeleteProgram(m_ProgramID);
+    throw renderer::CompilationError(std::move(Message));
+  }
+  ReflectUniforms();
+}
+
+auto renderer::gl::Program::AdoptLinked(GLuint program_id) -> Program
+{
+  Program Adopted(program_id);
+  Adopted.ReflectUniforms();
+  return Adopted;
+}
+
+auto renderer::gl::Program::CreateSeparable(GLenum shader_type,
+  std::string_view source) -> Program
+{
+  // glCreateShaderProgramv needs a null-terminated string
+  std::string const Source(source);
+  auto const *Text = Source.c_str();
+  Program Separable(glCreateShaderProgramv(shader_type, 1, &Text));
+  GLint ProgramLinked{};
+  glGetProgramiv(Separable.m_ProgramID, GL_LINK_STATUS, &ProgramLinked);
+  if (ProgramLinked != GL_TRUE) {
+    // The compile log of the stage is appended to the program's log
+    throw renderer::CompilationError(
+      GetProgramInfoLog(Separable.m_ProgramID));
+  }
+  Separable.ReflectUniforms();
+  return Separable;
+}
+
+auto renderer::gl::Program::FromBinary(ProgramBinary const &binary)
+  -> std::optional<Program>
+{
+  Program Loaded{};
+  glProgramBinary(Loaded.m_ProgramID,
+    binary.Format,
+    binary.Data.data(),
+    static_cast<GLsizei>(binary.Data.size()));
+  GLint ProgramLinked{};
+  glGetProgramiv(Loaded.m_ProgramID, GL_LINK_STATUS, &ProgramLinked);
+  if (ProgramLinked != GL_TRUE) { return std::nullopt; }
+  Loaded.ReflectUniforms();
+  return Loaded;
+}
+
+auto renderer::gl::Program::GetBinary() const -> std::optional<ProgramBinary>
+{
+  GLint Length{};
+  glGetProgramiv(m_ProgramID, GL_PROGRAM_BINARY_LENGTH, &Length);
+  if (Length <= 0) { return std::nullopt; }
+  ProgramBinary Binary{ .Format = 0,
+    .Data = std::vector<std::byte>(static_cast<std::size_t>(Length)) };
+  GLsizei Written{};
+  glGetProgramBinary(
+    m_ProgramID, Length, &Written, &Binary.Format, Binary.Data.data());
+  if (Written <= 0) { return std::nullopt; }
+  Binary.Data.resize(static_cast<std::size_t>(Written));
+  return Binary;
+}
+
+void renderer::gl::Program::ReflectUniforms()
+{
+  GLint UniformCount{};
+  glGetProgramiv(m_ProgramID, GL_ACTIVE_UNIFORMS, &UniformCount);
+  GLint MaxNameLength{};
+  glGetProgramiv(m_ProgramID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &MaxNameLength);
+
+  m_Uniforms.clear();
+  m_Uniforms.reserve(static_cast<std::size_t>(UniformCount));
+  std::string Name(static_cast<std::size_t>(std::max(MaxNameLength, 1)), '\0');
+  for (GLint Index = 0; Index < UniformCount; ++Index) {
+    GLsizei NameLength{};
+    GLint Size{};
+    GLenum Type{};
+    glGetActiveUniform(m_ProgramID,
+      static_cast<GLuint>(Index),
+      static_cast<GLsizei>(Name.size()),
+      &NameLength,
+      &Size,
+      &Type,
+      Name.data());
+    std::string const FullName(
+      Name.data(), static_cast<std::size_t>(NameLength));
+    auto const Location = glGetUniformLocation(m_ProgramID, FullName.c_str());
+    // Members of uniform blocks have no location and are set via buffers
+    if (Location == -1) { continue; }
+    m_Uniforms.push_back(UniformInfo{ .Name = std::string(
+                                        TrimArraySuffix(FullName)),
+      .Location = Location,
+      .Type = Type,
+      .Size = Size });
+  }
+  std::ranges::sort(m_Uniforms, {}, &UniformInfo::Name);
+  m_UniformShadows.assign(m_Uniforms.size(), UniformShadow{});
+}
+
+auto renderer::gl::Program::UpdateUniformShadow(std::uint32_t index,
+  std::span<std::byte const> value) noexcept -> bool
+{
+  auto &Shadow = m_UniformShadows[index];
+  auto const Stored = std::span{ Shadow.Value }.first(value.size());
+  if (Shadow.Valid && std::ranges::equal(Stored, value)) {
+    ++m_UniformUploadsElided;
+    return false;
+  }
+  std::ranges::copy(value, Stored.begin());
+  Shadow.Valid = true;
+  ++m_UniformUploads;
+  return true;
+}
+
+auto renderer::gl::Program::NextSerial() noexcept -> std::uint64_t
+{
+  static std::atomic<std::uint64_t> Counter{ 0 };
+  return Counter.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+void renderer::gl::Program::InvalidateUniformShadows() noexcept
+{
+  for (auto &Shadow : m_UniformShadows) { Shadow.Valid = false; }
+}
+
+void renderer::gl::Program::CollectStatistics(
+  FrameStatistics &statistics) noexcept
+{
+  statistics.UniformUploads += std::exchange(m_UniformUploads, 0);
+  statistics.UniformUploadsElided += std::exchange(m_UniformUploadsElided, 0);
+}
+
+auto renderer::gl::Program::FindUniform(std::string_view name) const noexcept
+  -> std::optional<UniformHandle>
+{
+  name = TrimArraySuffix(name);
+  auto const Found = std::ranges::lower_bound(m_Uniforms,
+    name,
+    {},
+    [](UniformInfo const &uniform) -> std::string_view {
+      return uniform.Name;
+    });
+  if (Found == m_Uniforms.end() || Found->Name != name) { return std::nullopt; }
+  return UniformHandle(Found->Location,
+    static_cast<std::uint32_t>(std::distance(m_Uniforms.begin(), Found)));
+}
+
+auto renderer::gl::Program::GetUniformHandle(std::string_view name) const
+  -> UniformHandle
+{
+  auto Handle = FindUniform(name);
+  if (!Handle.has_value()) {
+    throw renderer::UniformError(fmt::format("\"{}\" was not found", name));
+  }
+  return *Handle;
+}
@@ -0,0 +1,107 @@
+#include <renderer/buffer/streamingBuffer.hpp>
+
+#include <cstddef>
+#include <fmt/format.h>
+#include <iterator>
+#include <renderer/utils/frameStatistics.hpp>
+#include <span>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+constexpr GLbitfield kMappingFlags =
+  GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+constexpr GLuint64 kWaitTimeout = 1'000'000;// 1 ms in nanoseconds
+}// namespace
+
+renderer::gl::StreamingBuffer::StreamingBuffer(std::size_t region_size,
+  std::size_t region_count)
+  : m_RegionSize((region_size + kRegionAlignment - 1) / kRegionAlignment
+                 * kRegionAlignment),
+    m_Fences(region_count, nullptr)
+{
+  if (region_size == 0 || region_count == 0) {
+    throw std::invalid_argument(
+      "StreamingBuffer needs at least one region of at least one byte");
+  }
+  auto const Size = static_cast<GLsizeiptr>(m_RegionSize * region_count);
+  glCreateBuffers(1, &m_BufferID);
+  glNamedBufferStorage(m_BufferID, Size, nullptr, kMappingFlags);
+  m_Mapping = static_cast<std::byte *>(
+    glMapNamedBufferRange(m_BufferID, 0, Size, kMappingFlags));
+  if (m_Mapping == nullptr) {
+    // The destructor does not run for a constructor that throws
+    Release();
+    throw std::runtime_error(
+      fmt::format("Could not map a {} byte streaming buffer", Size));
+  }
+}
+
+renderer::gl::StreamingBuffer::StreamingBuffer(
+  StreamingBuffer &&other) noexcept
+  : m_BufferID(std::exchange(other.m_BufferID, 0)),
+    m_Mapping(std::exchange(other.m_Mapping, nullptr)),
+    m_RegionSize(other.m_RegionSize), m_Region(other.m_Region),
+    m_Fences(std::move(other.m_Fences)), m_Stalls(other.m_Stalls)
+{}
+
+auto renderer::gl::StreamingBuffer::operator=(StreamingBuffer &&other) noexcept
+  -> StreamingBuffer &
+{
+  if (this != &other) {
+    Release();
+    m_BufferID = std::exchange(other.m_BufferID, 0);
+    m_Mapping = std::exchange(other.m_Mapping, nullptr);
+    m_RegionSize = other.m_RegionSize;
+    m_Region = other.m_Region;
+    m_Fences = std::move(other.m_Fences);
+    m_Stalls = other.m_Stalls;
+  }
+  return *this;
+}
+
+void renderer::gl::StreamingBuffer::Release() noexcept
+{
+  for (auto &Fence : m_Fences) { glDeleteSync(std::exchange(Fence, nullptr)); }
+  if (m_Mapping != nullptr) { glUnmapNamedBuffer(m_BufferID); }
+  m_Mapping = nullptr;
+  glDeleteBuffers(1, &m_BufferID);
+  m_BufferID = 0;
+}
+
+void renderer::gl::StreamingBuffer::WaitForRegion(std::size_t region) noexcept
+{
+  auto &Fence = m_Fences[region];
+  if (Fence == nullptr) { return; }
+  // The first check flushes so the fence is guaranteed to signal eventually
+  auto Status = glClientWaitSync(Fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+  if (Status == GL_TIMEOUT_EXPIRED) {
+    ++m_Stalls;
+    do {
+      Status = glClientWaitSync(Fence, 0, kWaitTimeout);
+    } while (Status == GL_TIMEOUT_EXPIRED);
+  }
+  glDeleteSync(std::exchange(Fence, nullptr));
+}
+
+auto renderer::gl::StreamingBuffer::BeginRegion() noexcept
+  -> std::span<std::byte>
+{
+  WaitForRegion(m_Region);
+  return { std::next(m_Mapping, static_cast<std::ptrdiff_t>(GetRegionOffset())),
+    m_RegionSize };
+}
+
+void renderer::gl::StreamingBuffer::EndRegion() noexcept
+{
+  auto &Fence = m_Fences[m_Region];
+  glDeleteSync(Fence);
+  Fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  m_Region = (m_Region + 1) % m_Fences.size();
+}
+
+void renderer::gl::StreamingBuffer::CollectStatistics(
+  FrameStatistics &statistics) noexcept
+{
+  statistics.StreamingStalls += std::exchange(m_Stalls, 0);
+}
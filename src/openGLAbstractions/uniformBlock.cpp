@@ -0,0 +1,35 @@
+#include <renderer/shader/uniformBlock.hpp>
+
+#include <cstddef>
+#include <fmt/format.h>
+#include <renderer/error/error.hpp>
+#include <string>
+#include <string_view>
+
+void renderer::gl::BindUniformBlock(Program const &program,
+  std::string_view block_name,
+  GLuint binding_point,
+  [[maybe_unused]] std::size_t expected_size)
+{
+  std::string const Name(block_name);
+  auto const BlockIndex =
+    glGetUniformBlockIndex(program.GetProgramID(), Name.c_str());
+  if (BlockIndex == GL_INVALID_INDEX) {
+    throw renderer::UniformError(
+      fmt::format("Uniform block \"{}\" was not found", block_name));
+  }
+#ifndef NDEBUG
+  GLint BlockSize{};
+  glGetActiveUniformBlockiv(
+    program.GetProgramID(), BlockIndex, GL_UNIFORM_BLOCK_DATA_SIZE, &BlockSize);
+  if (static_cast<std::size_t>(BlockSize) != expected_size) {
+    throw renderer::UniformError(
+      fmt::format("Uniform block \"{}\" is {} bytes but its C++ struct lays "
+                  "out {} bytes",
+        block_name,
+        BlockSize,
+        expected_size));
+  }
+#endif
+  glUniformBlockBinding(program.GetProgramID(), BlockIndex, binding_point);
+}
@@ -0,0 +1,119 @@
+#include <renderer/buffer/vertexLayout.hpp>
+
+#include <cstddef>
+#include <span>
+
+void renderer::gl::SetupVertexArray(GLuint vertex_array,
+  GLuint buffer,
+  std::span<VertexAttribute const> attributes,
+  GLsizei stride,
+  VertexBufferBinding const &binding) noexcept
+{
+  if (GLAD_GL_VERSION_4_5 != 0) {
+    auto Location = binding.FirstLocation;
+    for (auto const &Attribute : attributes) {
+      switch (Attribute.Kind) {
+      case AttributeKind::Float:
+        glVertexArrayAttribFormat(vertex_array,
+          Location,
+          Attribute.Components,
+          Attribute.Type,
+          Attribute.Normalised ? GL_TRUE : GL_FALSE,
+          Attribute.Offset);
+        break;
+      case AttributeKind::Integer:
+        glVertexArrayAttribIFormat(vertex_array,
+          Location,
+          Attribute.Components,
+          Attribute.Type,
+          Attribute.Offset);
+        break;
+      case AttributeKind::Double:
+        glVertexArrayAttribLFormat(vertex_array,
+          Location,
+          Attribute.Components,
+          Attribute.Type,
+          Attribute.Offset);
+        break;
+      }
+      glVertexArrayAttribBinding(vertex_array, Location, binding.BindingIndex);
+      glEnableVertexArrayAttrib(vertex_array, Location);
+      ++Location;
+    }
+    glVertexArrayVertexBuffer(
+      vertex_array, binding.BindingIndex, buffer, binding.Offset, stride);
+    glVertexArrayBindingDivisor(
+      vertex_array, binding.BindingIndex, binding.Divisor);
+    return;
+  }
+  // Pre 4.5 contexts: the format is captured from the bound array buffer
+  glBindVertexArray(vertex_array);
+  glBindBuffer(GL_ARRAY_BUFFER, buffer);
+  auto Location = binding.FirstLocation;
+  for (auto const &Attribute : attributes) {
+    // NOLINTNEXTLINE(*-reinterpret-cast, performance-no-int-to-ptr)
+    auto const *Pointer = reinterpret_cast<void const *>(
+      binding.Offset + static_cast<GLintptr>(Attribute.Offset));
+    switch (Attribute.Kind) {
+    case AttributeKind::Float:
+      glVertexAttribPointer(Location,
+        Attribute.Components,
+        Attribute.Type,
+        Attribute.Normalised ? GL_TRUE : GL_FALSE,
+        stride,
+        Pointer);
+      break;
+    case AttributeKind::Integer:
+      glVertexAttribIPointer(
+        Location, Attribute.Components, Attribute.Type, stride, Pointer);
+      break;
+    case AttributeKind::Double:
+      glVertexAttribLPointer(
+        Location, Attribute.Components, Attribute.Type, stride, Pointer);
+      break;
+    }
+    glVertexAttribDivisor(Location, binding.Divisor);
+    glEnableVertexAttribArray(Location);
+    ++Location;
+  }
+  glBindVertexArray(0);
+}
+
+void renderer::gl::UploadGrowing(GLuint &buffer,
+  std::size_t &capacity,
+  std::span<std::byte const> bytes)
+{
+  if (GLAD_GL_VERSION_4_5 == 0) {
+    // Pre 4.5 contexts: mutable storage grows in place. The copy write
+    // target leaves the caller's array and element buffer bindings alone.
+    if (bytes.empty()) { return; }
+    if (buffer == 0) { glGenBuffers(1, &buffer); }
+    glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+    if (bytes.size() > capacity) {
+      glBufferData(GL_COPY_WRITE_BUFFER,
+        static_cast<GLsizeiptr>(bytes.size()),
+        bytes.data(),
+        GL_DYNAMIC_DRAW);
+      capacity = bytes.size();
+    } else {
+      glBufferSubData(GL_COPY_WRITE_BUFFER,
+        0,
+        static_cast<GLsizeiptr>(bytes.size()),
+        bytes.data());
+    }
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    return;
+  }
+  if (bytes.size() > capacity) {
+    glDeleteBuffers(1, &buffer);
+    glCreateBuffers(1, &buffer);
+    glNamedBufferStorage(buffer,
+      static_cast<GLsizeiptr>(bytes.size()),
+      bytes.data(),
+      GL_DYNAMIC_STORAGE_BIT);
+    capacity = bytes.size();
+  } else if (!bytes.empty()) {
+    glNamedBufferSubData(
+      buffer, 0, static_cast<GLsizeiptr>(bytes.size()), bytes.data());
+  }
+}
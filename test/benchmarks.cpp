@@ -0,0 +1,387 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+// NOLINTNEXTLINE
+#include <glad/glad.h>
+
+// NOLINTNEXTLINE
+#include <GLFW/glfw3.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <renderer/buffer/compactVertex.hpp>
+#include <renderer/colour/colourConversion.hpp>
+#include <renderer/colour/spectrum.hpp>
+#include <renderer/drawer/drawer.hpp>
+#include <renderer/point/point.hpp>
+#include <renderer/point/pointCloud.hpp>
+#include <renderer/shader/shader.hpp>
+#include <renderer/shape/polygonBatch.hpp>
+#include <renderer/vector/vector.hpp>
+#include <renderer/vector/vectorExpression.hpp>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "hiddenContext.hpp"
+
+using renderer::test::HiddenContext;
+
+namespace {
+constexpr std::size_t kDrawersPerFrame = 256;
+constexpr std::size_t kUploadedPoints = std::size_t{ 1 } << 20U;
+
+// Interleaved float position and float colour, as main.cpp used to upload
+struct FloatVertex
+{
+  renderer::Vector3<float> Position;
+  renderer::Vector3<float> Colour;
+};
+
+auto MakePoints() -> std::vector<renderer::Point3<float>>
+{
+  std::vector<renderer::Point3<float>> Points(kUploadedPoints);
+  for (std::size_t Index = 0; Index < Points.size(); ++Index) {
+    auto const Value = static_cast<float>(Index) * 0.001F;// NOLINT
+    Points[Index].m_PositionVector.m_Values = { Value, -Value, 0.5F };// NOLINT
+    Points[Index].m_ColourOfPoint.Red().Value =
+      static_cast<std::uint8_t>(Index);
+  }
+  return Points;
+}
+}// namespace
+
+TEST_CASE("Drawer call overhead against std::function", "[benchmark][Drawer]")
+{
+  int Sink = 0;
+  // Three captured pointers: beyond libstdc++'s std::function small buffer
+  int First = 1;
+  int Second = 2;
+  std::vector<std::function<void(int)>> Functions;
+  std::vector<renderer::drawer::Drawer<void(int)>> Drawers;
+  Functions.reserve(kDrawersPerFrame);
+  Drawers.reserve(kDrawersPerFrame);
+  for (std::size_t Index = 0; Index < kDrawersPerFrame; ++Index) {
+    Functions.emplace_back(
+      [&Sink, &First, &Second](int x) { Sink += x + First * Second; });
+    Drawers.emplace_back(
+      [&Sink, &First, &Second](int x) { Sink += x + First * Second; });
+  }
+
+  BENCHMARK("std::function frame")
+  {
+    for (auto &Function : Functions) { Function(1); }
+    return Sink;
+  };
+  BENCHMARK("Drawer frame")
+  {
+    for (auto &Drawer : Drawers) { Drawer.Draw(1); }
+    return Sink;
+  };
+  BENCHMARK("std::function construction")
+  {
+    return std::function<void(int)>(
+      [&Sink, &First, &Second](int x) { Sink += x + First * Second; });
+  };
+  BENCHMARK("Drawer construction")
+  {
+    return renderer::drawer::Drawer<void(int)>(
+      [&Sink, &First, &Second](int x) { Sink += x + First * Second; });
+  };
+}
+
+TEST_CASE("Packing points into compact vertices", "[benchmark][CompactVertex]")
+{
+  auto const Points = MakePoints();
+  std::vector<renderer::gl::CompactPoint3<>> Packed(Points.size());
+  std::vector<renderer::gl::CompactPoint3<renderer::gl::Snorm16>> Normalised(
+    Points.size());
+
+  BENCHMARK("PackPoints half")
+  {
+    renderer::gl::PackPoints(std::span(Points), std::span(Packed));
+    return Packed.back().Position.m_Values[0];
+  };
+  BENCHMARK("Scalar ToHalf")
+  {
+    for (std::size_t Index = 0; Index < Points.size(); ++Index) {
+      auto const &Position = Points[Index].m_PositionVector.m_Values;
+      for (std::size_t Axis = 0; Axis < 3; ++Axis) {
+        Packed[Index].Position.m_Values[Axis] =
+          renderer::gl::ToHalf(Position[Axis]);
+      }
+    }
+    return Packed.back().Position.m_Values[0];
+  };
+  BENCHMARK("PackPoints snorm16")
+  {
+    renderer::gl::PackPoints(std::span(Points), std::span(Normalised));
+    return Normalised.back().Position.m_Values[0];
+  };
+}
+
+TEST_CASE("Uploading points by vertex format", "[benchmark][CompactVertex]")
+{
+  HiddenContext const Context;
+  if (!Context) { SKIP("No OpenGL 4.5 context available"); }
+
+  auto const Points = MakePoints();
+  std::vector<FloatVertex> FloatVertices(Points.size());
+  std::vector<renderer::gl::CompactPoint3<>> Packed(Points.size());
+  renderer::gl::PackPoints(std::span(Points), std::span(Packed));
+
+  GLuint Buffer{};
+  glCreateBuffers(1, &Buffer);
+  glNamedBufferStorage(Buffer,
+    static_cast<GLsizeiptr>(FloatVertices.size() * sizeof(FloatVertex)),
+    nullptr,
+    GL_DYNAMIC_STORAGE_BIT);
+  // glFinish makes each sample include the transfer, not just the queueing
+  auto Upload = [Buffer](auto const &vertices) {
+    auto const Bytes = std::as_bytes(std::span(vertices));
+    glNamedBufferSubData(
+      Buffer, 0, static_cast<GLsizeiptr>(Bytes.size()), Bytes.data());
+    glFinish();
+    return Bytes.size();
+  };
+
+  BENCHMARK("24 byte float position and colour")
+  {
+    return Upload(FloatVertices);
+  };
+  BENCHMARK("16 byte renderer::Point3<float>") { return Upload(Points); };
+  BENCHMARK("12 byte CompactPoint3 with packing")
+  {
+    renderer::gl::PackPoints(std::span(Points), std::span(Packed));
+    return Upload(Packed);
+  };
+  BENCHMARK("12 byte CompactPoint3, prepacked") { return Upload(Packed); };
+  glDeleteBuffers(1, &Buffer);
+}
+
+TEST_CASE("Vector expressions against scalar loops", "[benchmark][Vector]")
+{
+  constexpr std::size_t kRays = std::size_t{ 1 } << 16U;
+  std::vector<renderer::Vector4<float>> Origins(kRays);
+  std::vector<renderer::Vector4<float>> Directions(kRays);
+  std::vector<renderer::Vector4<float>> Result(kRays);
+  for (std::size_t Index = 0; Index < kRays; ++Index) {
+    auto const Value = static_cast<float>(Index) * 0.001F;// NOLINT
+    Origins[Index].m_Values = { Value, 1.0F, -Value, 0.0F };
+    Directions[Index].m_Values = { 0.5F, -Value, 2.0F, 0.0F };// NOLINT
+  }
+  constexpr float kDistance = 3.0F;
+
+  BENCHMARK("Scalar advance and normalise")
+  {
+    for (std::size_t Index = 0; Index < kRays; ++Index) {
+      auto const &Origin = Origins[Index].m_Values;
+      auto const &Direction = Directions[Index].m_Values;
+      auto &Out = Result[Index].m_Values;
+      float LengthSquared = 0.0F;
+      for (std::size_t Axis = 0; Axis < 4; ++Axis) {
+        Out[Axis] = Origin[Axis] + Direction[Axis] * kDistance;
+        LengthSquared += Out[Axis] * Out[Axis];
+      }
+      auto const Scale = 1.0F / std::sqrt(LengthSquared);
+      for (auto &Component : Out) { Component *= Scale; }
+    }
+    return Result.back().m_Values[0];
+  };
+  BENCHMARK("Expression advance and normalise")
+  {
+    for (std::size_t Index = 0; Index < kRays; ++Index) {
+      Result[Index] =
+        renderer::Normalise(Origins[Index] + Directions[Index] * kDistance);
+    }
+    return Result.back().m_Values[0];
+  };
+  BENCHMARK("Scalar dot products")
+  {
+    float Sum = 0.0F;
+    for (std::size_t Index = 0; Index < kRays; ++Index) {
+      for (std::size_t Axis = 0; Axis < 4; ++Axis) {
+        Sum += Origins[Index].m_Values[Axis] * Directions[Index].m_Values[Axis];
+      }
+    }
+    return Sum;
+  };
+  BENCHMARK("Expression dot products")
+  {
+    float Sum = 0.0F;
+    for (std::size_t Index = 0; Index < kRays; ++Index) {
+      Sum += renderer::Dot(Origins[Index], Directions[Index]);
+    }
+    return Sum;
+  };
+}
+
+TEST_CASE("Transforming positions by point layout", "[benchmark][PointCloud]")
+{
+  auto Points = MakePoints();
+  renderer::PointCloud3<float> Cloud{ std::span<renderer::Point3<float> const>{
+    Points } };
+  // A reflection, so repeated runs neither overflow nor reach subnormals
+  renderer::Vector3<float> const Scale{ { -1.0F, -1.0F, -1.0F } };
+  renderer::Vector3<float> const Offset{ { 0.5F, 1.0F, -1.0F } };// NOLINT
+
+  BENCHMARK("Array of renderer::Point3<float>")
+  {
+    for (auto &Point : Points) {
+      auto &Position = Point.m_PositionVector.m_Values;
+      for (std::size_t Axis = 0; Axis < 3; ++Axis) {
+        Position[Axis] =
+          Position[Axis] * Scale.m_Values[Axis] + Offset.m_Values[Axis];
+      }
+    }
+    return Points.back().m_PositionVector.m_Values[0];
+  };
+  BENCHMARK("PointCloud3<float>")
+  {
+    Cloud.Transform(Scale, Offset);
+    return Cloud.GetCoordinates(0).back();
+  };
+}
+
+TEST_CASE("Converting an RGBA8 image to floats and back", "[benchmark][Colour]")
+{
+  constexpr std::size_t kPixels = std::size_t{ 1024 } * 1024;
+  std::vector<std::uint32_t> Image(kPixels);
+  for (std::size_t Index = 0; Index < kPixels; ++Index) {
+    Image[Index] = static_cast<std::uint32_t>(Index * 2654435761U);// NOLINT
+  }
+  std::vector<renderer::Vector4<float>> Floats(kPixels);
+  std::vector<std::uint32_t> Packed(kPixels);
+
+  BENCHMARK("Scalar unpack")
+  {
+    for (std::size_t Index = 0; Index < kPixels; ++Index) {
+      for (std::size_t Channel = 0; Channel < 4; ++Channel) {
+        auto const Byte =
+          static_cast<std::uint8_t>(Image[Index] >> (8 * Channel));
+        Floats[Index].m_Values[Channel] =
+          renderer::RedNormalised(renderer::Red{ Byte }).Value();
+      }
+    }
+    return Floats.back().m_Values[0];
+  };
+  BENCHMARK("UnpackRGBA8")
+  {
+    renderer::UnpackRGBA8(Image, Floats);
+    return Floats.back().m_Values[0];
+  };
+  BENCHMARK("Scalar pack")
+  {
+    for (std::size_t Index = 0; Index < kPixels; ++Index) {
+      std::uint32_t Pixel = 0;
+      for (std::size_t Channel = 0; Channel < 4; ++Channel) {
+        Pixel |= std::uint32_t{ renderer::QuantiseChannel(
+                   Floats[Index].m_Values[Channel]) }
+                 << (8 * Channel);
+      }
+      Packed[Index] = Pixel;
+    }
+    return Packed.back();
+  };
+  BENCHMARK("PackRGBA8")
+  {
+    renderer::PackRGBA8(Floats, Packed);
+    return Packed.back();
+  };
+}
+
+TEST_CASE("Colouring rays by wavelength", "[benchmark][Spectrum]")
+{
+  constexpr std::size_t kRays = std::size_t{ 1 } << 16U;
+  std::vector<float> Wavelengths(kRays);
+  for (std::size_t Index = 0; Index < kRays; ++Index) {
+    Wavelengths[Index] =
+      380.0F + static_cast<float>((Index * 7919U) % 4001U) / 10.0F;// NOLINT
+  }
+  std::vector<renderer::Vector3<float>> Colours(kRays);
+  auto const &Table = renderer::kSpectrumTable;
+
+  BENCHMARK("Colour matching functions per ray")
+  {
+    for (std::size_t Index = 0; Index < kRays; ++Index) {
+      auto Colour = renderer::XyzToLinearSrgb(
+        renderer::CieColourMatching(Wavelengths[Index]));
+      auto const Lowest = std::min(
+        { Colour.m_Values[0], Colour.m_Values[1], Colour.m_Values[2] });
+      for (std::size_t Channel = 0; Channel < 3; ++Channel) {
+        Colours[Index].m_Values[Channel] =
+          static_cast<float>(Colour.m_Values[Channel] - std::min(Lowest, 0.0));
+      }
+    }
+    return Colours.back().m_Values[0];
+  };
+  BENCHMARK("SpectrumTable::SampleLinear")
+  {
+    Table.SampleLinear(Wavelengths, Colours);
+    return Colours.back().m_Values[0];
+  };
+}
+
+TEST_CASE("Drawing many concave polygons", "[benchmark][Polygon]")
+{
+  HiddenContext const Context;
+  if (!Context) { SKIP("No OpenGL 4.5 context available"); }
+
+  // Arrowheads on a 32 x 32 grid, each needing ear clipping
+  constexpr std::size_t kSide = 32;
+  constexpr float kCell = 2.0F / kSide;
+  std::vector<renderer::Polygon<float, 4>> Arrowheads(kSide * kSide);
+  for (std::size_t Index = 0; Index < Arrowheads.size(); ++Index) {
+    auto const X = static_cast<float>(Index % kSide) * kCell - 1.0F;
+    auto const Y = static_cast<float>(Index / kSide) * kCell - 1.0F;
+    auto &Corners = Arrowheads[Index].m_Corners;
+    Corners[0].m_PositionVector.m_Values = { X, Y };
+    Corners[1].m_PositionVector.m_Values = { X + kCell, Y + kCell / 2 };
+    Corners[2].m_PositionVector.m_Values = { X, Y + kCell };
+    Corners[3].m_PositionVector.m_Values = { X + kCell / 4, Y + kCell / 2 };
+  }
+  renderer::gl::PolygonBatch<float> Batch;
+  Batch.Reserve(Arrowheads.size(), 4 * Arrowheads.size());
+  for (auto const &Arrowhead : Arrowheads) { Batch.Add(Arrowhead); }
+  renderer::gl::PolygonRenderer Polygons;
+  Polygons.Upload(Batch);
+  renderer::gl::Program const Flat(
+    renderer::gl::ShaderUnit<GL_VERTEX_SHADER>(R"glsl(#version 450 core
+      layout(location = 0) in vec2 aPosition;
+      void main() { gl_Position = vec4(aPosition, 0.0, 1.0); })glsl"),
+    renderer::gl::ShaderUnit<GL_FRAGMENT_SHADER>(R"glsl(#version 450 core
+      out vec4 FragColour;
+      void main() { FragColour = vec4(1.0); })glsl"));
+  Flat.Use();
+
+  BENCHMARK("Triangulating into a PolygonBatch")
+  {
+    Batch.Clear();
+    for (auto const &Arrowhead : Arrowheads) { Batch.Add(Arrowhead); }
+    return Batch.GetTriangleCount();
+  };
+  // The same buffers either way, so only the submission differs
+  BENCHMARK("One glDrawElements per polygon")
+  {
+    glBindVertexArray(Polygons.GetVertexArray());
+    constexpr GLsizei kIndicesEach = 6;
+    for (std::size_t Index = 0; Index < Arrowheads.size(); ++Index) {
+      glDrawElements(GL_TRIANGLES,
+        kIndicesEach,
+        GL_UNSIGNED_INT,
+        // NOLINTNEXTLINE(performance-no-int-to-ptr)
+        reinterpret_cast<void const *>(
+          Index * kIndicesEach * sizeof(GLuint)));
+    }
+    glFinish();
+    return Arrowheads.size();
+  };
+  BENCHMARK("PolygonRenderer::Draw")
+  {
+    Polygons.Draw();
+    glFinish();
+    return Polygons.GetIndexCount();
+  };
+}
@@ -1,3 +1,407 @@
 #include <catch2/catch_test_macros.hpp>
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <renderer/buffer/compactVertex.hpp>
+#include <renderer/buffer/vertexLayout.hpp>
+#include <renderer/colour/spectrum.hpp>
+#include <renderer/point/point.hpp>
+#include <renderer/shader/computeProgram.hpp>
+#include <renderer/shader/std140.hpp>
+#include <renderer/shape/triangulation.hpp>
+#include <renderer/utils/constexprMath.hpp>
+#include <renderer/utils/hash.hpp>
+#include <renderer/vector/vector.hpp>
+#include <renderer/vector/vectorExpression.hpp>
+#include <tuple>
+
 TEST_CASE("Stuff", "Hi") {}
+
+namespace {
+namespace std140 = renderer::gl::std140;
+struct Sellmeier
+{
+  renderer::Vector3<float> B;
+  float Padding0;
+  renderer::Vector3<float> C;
+  float Padding1;
+};
+struct OpticsParameters
+{
+  renderer::Vector2<float> WavelengthRange;
+  float FocalLength;
+  int SurfaceCount;
+  renderer::Vector3<float> LensCentre;
+  float RefractiveIndex;
+  std::array<renderer::Vector4<float>, 2> Apertures;
+  Sellmeier Glass;
+};
+struct Misaligned
+{
+  float Scale;
+  renderer::Vector3<float> Direction;
+};
+struct ScalarArray
+{
+  std::array<float, 3> Coefficients;
+};
+struct SwappedBlock
+{
+  float Scale;
+  int Count;
+};
+struct RayVertex
+{
+  renderer::Vector2<float> Position;
+  std::uint16_t Bounce;
+  renderer::Vector4<std::uint8_t> Colour;
+  double Wavelength;
+};
+struct PartialVertex
+{
+  renderer::Vector3<float> Position;
+  float Unlisted;
+};
+struct SwappedVertex
+{
+  float Intensity;
+  std::uint32_t Bounces;
+};
+}// namespace
+
+template<> struct renderer::gl::std140::Members<Sellmeier>
+{
+  static constexpr std::tuple kList{ &Sellmeier::B,
+    &Sellmeier::Padding0,
+    &Sellmeier::C,
+    &Sellmeier::Padding1 };
+};
+template<> struct renderer::gl::std140::Members<OpticsParameters>
+{
+  static constexpr std::tuple kList{ &OpticsParameters::WavelengthRange,
+    &OpticsParameters::FocalLength,
+    &OpticsParameters::SurfaceCount,
+    &OpticsParameters::LensCentre,
+    &OpticsParameters::RefractiveIndex,
+    &OpticsParameters::Apertures,
+    &OpticsParameters::Glass };
+};
+template<> struct renderer::gl::std140::Members<Misaligned>
+{
+  static constexpr std::tuple kList{ &Misaligned::Scale,
+    &Misaligned::Direction };
+};
+template<> struct renderer::gl::std140::Members<ScalarArray>
+{
+  static constexpr std::tuple kList{ &ScalarArray::Coefficients };
+};
+template<> struct renderer::gl::std140::Members<SwappedBlock>
+{
+  static constexpr std::tuple kList{ &SwappedBlock::Count,
+    &SwappedBlock::Scale };
+};
+
+template<> struct renderer::gl::VertexMembers<RayVertex>
+{
+  static constexpr std::tuple kList{ &RayVertex::Position,
+    &RayVertex::Bounce,
+    &RayVertex::Colour,
+    &RayVertex::Wavelength };
+};
+template<> struct renderer::gl::VertexMembers<PartialVertex>
+{
+  static constexpr std::tuple kList{ &PartialVertex::Position };
+};
+template<> struct renderer::gl::VertexMembers<SwappedVertex>
+{
+  static constexpr std::tuple kList{ &SwappedVertex::Bounces,
+    &SwappedVertex::Intensity };
+};
+
+TEST_CASE("std140 base alignment and size", "[std140]")
+{
+  STATIC_REQUIRE((std140::LayoutOf<float>().BaseAlignment == 4));
+  STATIC_REQUIRE((std140::LayoutOf<double>().Size == 8));
+  STATIC_REQUIRE(
+    (std140::LayoutOf<renderer::Vector2<float>>().BaseAlignment == 8));
+  STATIC_REQUIRE(
+    (std140::LayoutOf<renderer::Vector3<float>>().BaseAlignment == 16));
+  STATIC_REQUIRE((std140::LayoutOf<renderer::Vector3<float>>().Size == 12));
+  STATIC_REQUIRE(
+    (std140::LayoutOf<renderer::Vector3<double>>().BaseAlignment == 32));
+  STATIC_REQUIRE((std140::LayoutOf<std::array<float, 3>>().Size == 48));
+  STATIC_REQUIRE((std140::LayoutOf<Sellmeier>().Size == 32));
+}
+
+TEST_CASE("std140 offsets of a struct", "[std140]")
+{
+  STATIC_REQUIRE((std140::Std140Offsets<OpticsParameters>()
+                  == std::array<std::size_t, 7>{ 0, 8, 12, 16, 28, 32, 64 }));
+  STATIC_REQUIRE((std140::LayoutOf<OpticsParameters>().Size == 96));
+  STATIC_REQUIRE(std140::block<OpticsParameters>);
+  STATIC_REQUIRE(std140::block<Sellmeier>);
+}
+
+TEST_CASE("std140 layout mismatches are detected", "[std140]")
+{
+  STATIC_REQUIRE((std140::FirstMismatch<Misaligned>() == 1));
+  STATIC_REQUIRE((std140::FirstMismatch<ScalarArray>() == 0));
+  STATIC_REQUIRE(!std140::block<Misaligned>);
+  STATIC_REQUIRE(!std140::block<ScalarArray>);
+  STATIC_REQUIRE(std140::ListsAllMembers<OpticsParameters>());
+  // Same size and alignment as the struct, but in the wrong order
+  STATIC_REQUIRE(!std140::ListsAllMembers<SwappedBlock>());
+  STATIC_REQUIRE(!std140::block<SwappedBlock>);
+}
+
+TEST_CASE("FNV-1a matches the reference values", "[hash]")
+{
+  using renderer::utils::Fnv1a;
+  STATIC_REQUIRE(Fnv1a("") == 0xcbf29ce484222325ULL);
+  STATIC_REQUIRE(Fnv1a("a") == 0xaf63dc4c8601ec8cULL);
+  STATIC_REQUIRE(Fnv1a("b", Fnv1a("a")) == Fnv1a("ab"));
+  STATIC_REQUIRE(Fnv1a(2, Fnv1a("ab")) != Fnv1a(1, Fnv1a("ab")));
+}
+
+TEST_CASE("Compute dispatches cover every invocation", "[ComputeProgram]")
+{
+  using renderer::gl::DispatchSize;
+  using renderer::gl::GetWorkGroupCount;
+  STATIC_REQUIRE(GetWorkGroupCount({ 100 }, { 64 }) == DispatchSize{ 2 });
+  STATIC_REQUIRE(GetWorkGroupCount({ 128 }, { 64 }) == DispatchSize{ 2 });
+  STATIC_REQUIRE(GetWorkGroupCount({ 800, 600, 1 }, { 16, 16, 1 })
+                 == DispatchSize{ 50, 38, 1 });
+}
+
+TEST_CASE("Vertex layouts follow the C++ struct", "[VertexLayout]")
+{
+  using renderer::gl::AttributeKind;
+  using renderer::gl::VertexAttribute;
+  using renderer::gl::VertexLayout;
+  using PointLayout = VertexLayout<renderer::Point3<float>>;
+  STATIC_REQUIRE(PointLayout::kStride == sizeof(renderer::Point3<float>));
+  STATIC_REQUIRE(PointLayout::kAttributes[0]
+                 == VertexAttribute{ 3, GL_FLOAT, false, {}, 0 });
+  STATIC_REQUIRE(PointLayout::kAttributes[1]
+                 == VertexAttribute{ 3, GL_UNSIGNED_BYTE, true, {}, 12 });
+
+  using RayLayout = VertexLayout<RayVertex>;
+  STATIC_REQUIRE(RayLayout::kStride == 24);
+  STATIC_REQUIRE(RayLayout::kAttributeCount == 4);
+  STATIC_REQUIRE(RayLayout::kAttributes[1]
+                 == VertexAttribute{
+                   1, GL_UNSIGNED_SHORT, false, AttributeKind::Integer, 8 });
+  STATIC_REQUIRE(RayLayout::kAttributes[2].Offset == 10);
+  STATIC_REQUIRE(RayLayout::kAttributes[3]
+                 == VertexAttribute{
+                   1, GL_DOUBLE, false, AttributeKind::Double, 16 });
+
+  using PositionLayout = VertexLayout<renderer::Vector2<float>>;
+  STATIC_REQUIRE(PositionLayout::kStride == 8);
+  STATIC_REQUIRE(PositionLayout::kAttributeCount == 1);
+}
+
+TEST_CASE("Vertex layouts must list every member", "[VertexLayout]")
+{
+  STATIC_REQUIRE(renderer::gl::ListsAllVertexMembers<RayVertex>());
+  STATIC_REQUIRE(!renderer::gl::ListsAllVertexMembers<PartialVertex>());
+  // Same size and alignment as the struct, but in the wrong order
+  STATIC_REQUIRE(!renderer::gl::ListsAllVertexMembers<SwappedVertex>());
+}
+
+TEST_CASE("Half conversion rounds like the hardware", "[CompactVertex]")
+{
+  using renderer::gl::ToFloat;
+  using renderer::gl::ToHalf;
+  STATIC_REQUIRE(ToHalf(1.0F).Bits == 0x3C00);
+  STATIC_REQUIRE(ToHalf(-2.0F).Bits == 0xC000);
+  STATIC_REQUIRE(ToHalf(65504.0F).Bits == 0x7BFF);
+  // Halfway between 65504 and the next step rounds up to infinity
+  STATIC_REQUIRE(ToHalf(65520.0F).Bits == 0x7C00);
+  // Ties go to the even neighbour: 2049 sits between 2048 and 2050
+  STATIC_REQUIRE(ToHalf(2049.0F).Bits == ToHalf(2048.0F).Bits);
+  STATIC_REQUIRE(ToHalf(5.9604645e-8F).Bits == 0x0001);
+  STATIC_REQUIRE(ToHalf(2.9802322e-8F).Bits == 0x0000);
+  STATIC_REQUIRE(ToFloat(ToHalf(0.333F)) == 0.33300781F);
+  STATIC_REQUIRE(ToFloat({ 0x0001 }) == 5.9604645e-8F);
+  STATIC_REQUIRE(renderer::gl::ToSnorm16(-3.0F).Value == -32767);
+  STATIC_REQUIRE(renderer::gl::ToSnorm16(0.5F).Value == 16384);
+}
+
+TEST_CASE("Compact points halve the vertex size", "[CompactVertex]")
+{
+  using renderer::gl::AttributeKind;
+  using renderer::gl::VertexAttribute;
+  using Layout = renderer::gl::VertexLayout<renderer::gl::CompactPoint3<>>;
+  STATIC_REQUIRE(Layout::kStride == 12);
+  STATIC_REQUIRE(Layout::kAttributes[0]
+                 == VertexAttribute{
+                   4, GL_HALF_FLOAT, false, AttributeKind::Float, 0 });
+  STATIC_REQUIRE(Layout::kAttributes[1]
+                 == VertexAttribute{
+                   4, GL_UNSIGNED_BYTE, true, AttributeKind::Float, 8 });
+  using SnormLayout = renderer::gl::VertexLayout<
+    renderer::gl::CompactPoint2<renderer::gl::Snorm16>>;
+  STATIC_REQUIRE(SnormLayout::kStride == 8);
+  STATIC_REQUIRE(SnormLayout::kAttributes[0]
+                 == VertexAttribute{
+                   2, GL_SHORT, true, AttributeKind::Float, 0 });
+}
+
+TEST_CASE("Vector expressions evaluate at compile time", "[renderer::Vector]")
+{
+  using renderer::Vector3;
+  constexpr Vector3<float> A{ { 1.0F, 2.0F, 3.0F } };
+  constexpr Vector3<float> B{ { 4.0F, -5.0F, 6.0F } };
+  constexpr Vector3<float> Fused = A * 2.0F + B - -A / 2;
+  STATIC_REQUIRE(Fused.m_Values == std::array{ 6.5F, 0.0F, 13.5F });
+  STATIC_REQUIRE(renderer::Evaluate(A * B).m_Values
+                 == std::array{ 4.0F, -10.0F, 18.0F });
+  STATIC_REQUIRE(renderer::Dot(A, B) == 12.0F);
+  STATIC_REQUIRE(renderer::Cross(A, B).m_Values
+                 == std::array{ 27.0F, 6.0F, -13.0F });
+  STATIC_REQUIRE(renderer::Length(renderer::Vector2<double>{ { 3.0, 4.0 } })
+                 == 5.0);
+  // A NaN component comes back out rather than stalling Newton's method
+  constexpr auto kNaN = std::numeric_limits<double>::quiet_NaN();
+  constexpr auto NaNLength =
+    renderer::Length(renderer::Vector2<double>{ { kNaN, 1.0 } });
+  STATIC_REQUIRE(NaNLength != NaNLength);
+  STATIC_REQUIRE(renderer::Normalise(Vector3<float>{ { 0.0F, 0.0F, -2.0F } })
+                   .m_Values
+                 == std::array{ 0.0F, 0.0F, -1.0F });
+  STATIC_REQUIRE(renderer::Evaluate(renderer::Lerp(A, B, 0.5F)).m_Values
+                 == std::array{ 2.5F, -1.5F, 4.5F });
+  STATIC_REQUIRE(
+    renderer::Evaluate(renderer::Lerp(A, B, 1.0F)).m_Values == B.m_Values);
+
+  constexpr Vector3<float> Up{ { 0.0F, 1.0F, 0.0F } };
+  constexpr Vector3<float> Down{ { 0.6F, -0.8F, 0.0F } };
+  STATIC_REQUIRE(renderer::Evaluate(renderer::Reflect(Down, Up)).m_Values
+                 == std::array{ 0.6F, 0.8F, 0.0F });
+  // Straight through at normal incidence, and totally reflected when
+  // leaving glass at a grazing angle
+  constexpr Vector3<double> Normal{ { 0.0, 1.0, 0.0 } };
+  constexpr Vector3<double> Incident{ { 0.0, -1.0, 0.0 } };
+  STATIC_REQUIRE(renderer::Refract(Incident, Normal, 1.0 / 1.5)->m_Values
+                 == Incident.m_Values);
+  constexpr Vector3<double> Grazing{ { 0.8, -0.6, 0.0 } };
+  STATIC_REQUIRE(!renderer::Refract(Grazing, Normal, 1.5).has_value());
+}
+
+TEST_CASE("Exp, Log and Pow evaluate at compile time", "[renderer::math]")
+{
+  using renderer::math::Exp;
+  using renderer::math::Log;
+  using renderer::math::Pow;
+  constexpr auto Near = [](double value, double expected) {
+    auto const Difference = value - expected;
+    return (Difference < 0 ? -Difference : Difference) <= 1e-15 * expected;
+  };
+  STATIC_REQUIRE(Exp(0.0) == 1.0);
+  STATIC_REQUIRE(Near(Exp(1.0), 2.718281828459045));
+  STATIC_REQUIRE(Near(Exp(-20.0), 2.061153622438558e-09));
+  STATIC_REQUIRE(Log(1.0) == 0.0);
+  STATIC_REQUIRE(Near(Log(10.0), 2.302585092994046));
+  STATIC_REQUIRE(Near(Pow(2.0, 10.0), 1024.0));
+  STATIC_REQUIRE(Near(Pow(0.5, 1.0 / 2.4), 0.7491535384383409));
+  STATIC_REQUIRE(Pow(0.0, 2.0) == 0.0);
+}
+
+TEST_CASE("The spectrum table is built at compile time", "[renderer::Spectrum]")
+{
+  constexpr auto const &Table = renderer::kSpectrumTable;
+  constexpr auto Dominant = [](renderer::Vector3<float> const &colour) {
+    auto const [R, G, B] = colour.m_Values;
+    if (R > G && R > B) { return 0; }
+    return G > B ? 1 : 2;
+  };
+  STATIC_REQUIRE(Dominant(Table.SampleLinear(700.0F)) == 0);
+  STATIC_REQUIRE(Dominant(Table.SampleLinear(550.0F)) == 1);
+  STATIC_REQUIRE(Dominant(Table.SampleLinear(450.0F)) == 2);
+  // Gamut clipping leaves no negative channels, and both ends are dark
+  STATIC_REQUIRE(std::ranges::all_of(Table.m_Linear, [](auto const &colour) {
+    return std::ranges::all_of(
+      colour.m_Values, [](float channel) { return channel >= 0.0F; });
+  }));
+  STATIC_REQUIRE(Table.SampleColour(380.0F).Red().Value < 32);
+  STATIC_REQUIRE(Table.SampleColour(780.0F).Red().Value < 8);
+
+  // A coarser table interpolates to the same hues
+  constexpr auto Coarse = renderer::MakeSpectrumTable<41>();
+  STATIC_REQUIRE(Dominant(Coarse.SampleLinear(653.0F)) == 0);
+  STATIC_REQUIRE(Dominant(Coarse.SampleLinear(527.0F)) == 1);
+}
+
+namespace {
+template<std::size_t Corners>
+constexpr auto MakeOutline(std::array<std::array<float, 2>, Corners> corners)
+{
+  renderer::Polygon<float, Corners> Outline;
+  for (std::size_t Index = 0; Index < Corners; ++Index) {
+    Outline.m_Corners[Index].m_PositionVector.m_Values = corners[Index];
+  }
+  return Outline;
+}
+
+// Twice the area covered by the triangles, or -1 if any of them winds the
+// other way to the outline
+template<std::size_t Corners, std::size_t IndexCount>
+constexpr auto CoveredArea(renderer::Polygon<float, Corners> const &outline,
+  std::array<std::uint32_t, IndexCount> const &indices) -> float
+{
+  using Corner = renderer::Point2<float>;
+  auto const Whole =
+    renderer::DoubleSignedArea(std::span<Corner const>(outline.m_Corners));
+  float Area = 0.0F;
+  for (std::size_t First = 0; First < IndexCount; First += 3) {
+    auto const Triangle = std::array{ outline.m_Corners[indices[First]],
+      outline.m_Corners[indices[First + 1]],
+      outline.m_Corners[indices[First + 2]] };
+    auto const Part =
+      renderer::DoubleSignedArea(std::span<Corner const>(Triangle));
+    if (Part * Whole < 0.0F) { return -1.0F; }
+    Area += Part < 0.0F ? -Part : Part;
+  }
+  return Area;
+}
+}// namespace
+
+TEST_CASE("Polygons triangulate at compile time", "[renderer::Triangulate]")
+{
+  // Convex polygons take the fan from corner 0
+  constexpr auto Square =
+    MakeOutline<4>({ { { 0, 0 }, { 1, 0 }, { 1, 1 }, { 0, 1 } } });
+  STATIC_REQUIRE(renderer::Triangulate(Square)
+                 == std::array<std::uint32_t, 6>{ 0, 1, 2, 0, 2, 3 });
+  STATIC_REQUIRE(renderer::Triangulate(renderer::Triangle<float>{})
+                 == renderer::kFanIndices<3>);
+
+  // A fan from corner 0 of this arrowhead would cover its notch at corner 3
+  constexpr auto Arrowhead =
+    MakeOutline<4>({ { { 0, 0 }, { 4, 2 }, { 0, 4 }, { 1, 2 } } });
+  STATIC_REQUIRE(renderer::Triangulate(Arrowhead)
+                 == std::array<std::uint32_t, 6>{ 3, 0, 1, 1, 2, 3 });
+
+  // Both windings of a U shape are covered exactly once
+  constexpr auto U = MakeOutline<8>({ { { 0, 0 },
+    { 3, 0 },
+    { 3, 3 },
+    { 2, 3 },
+    { 2, 1 },
+    { 1, 1 },
+    { 1, 3 },
+    { 0, 3 } } });
+  STATIC_REQUIRE(!renderer::IsConvex(
+    std::span<renderer::Point2<float> const>(U.m_Corners)));
+  STATIC_REQUIRE(CoveredArea(U, renderer::Triangulate(U)) == 14.0F);
+  constexpr auto Clockwise = [&] {
+    auto Reversed = U;
+    std::ranges::reverse(Reversed.m_Corners);
+    return Reversed;
+  }();
+  STATIC_REQUIRE(
+    CoveredArea(Clockwise, renderer::Triangulate(Clockwise)) == 14.0F);
+}
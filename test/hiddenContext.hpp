@@ -0,0 +1,157 @@
+#pragma once
+#include <glad/glad.h>//
+//
+#include <GLFW/glfw3.h>
+#include <cstddef>
+#include <cstdint>
+#include <renderer/object/glObject.hpp>
+#include <utility>
+#include <vector>
+
+namespace renderer::test {
+
+// Hidden window with a GL 4.5 core context that is current while it lives.
+// ctest runs the tests with LIBGL_ALWAYS_SOFTWARE=1, so Mesa's llvmpipe
+// provides the context on machines without a GPU; without any display it is
+// empty and GL tests and benchmarks skip themselves.
+class HiddenContext
+{
+  GLFWwindow *m_Window{};
+
+public:
+  HiddenContext()
+  {
+    if (glfwInit() == 0) { return; }
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 5);// NOLINT
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    m_Window = glfwCreateWindow(1, 1, "renderer tests", nullptr, nullptr);
+    if (m_Window == nullptr) { return; }
+    glfwMakeContextCurrent(m_Window);
+    if (gladLoadGL() == 0) {
+      glfwDestroyWindow(std::exchange(m_Window, nullptr));
+    }
+  }
+  HiddenContext(HiddenContext const &) = delete;
+  HiddenContext(HiddenContext &&) = delete;
+  auto operator=(HiddenContext const &) -> HiddenContext & = delete;
+  auto operator=(HiddenContext &&) -> HiddenContext & = delete;
+  ~HiddenContext()
+  {
+    if (m_Window != nullptr) { glfwDestroyWindow(m_Window); }
+    glfwTerminate();
+  }
+  [[nodiscard]] explicit operator bool() const noexcept
+  {
+    return m_Window != nullptr;
+  }
+};
+
+// Square offscreen colour target for draw tests. It is bound as the
+// framebuffer, with a viewport covering it, from construction until
+// destruction, and its handles free the GL objects even when a failed
+// REQUIRE leaves the test early.
+class RenderTarget
+{
+  gl::ObjectPool m_Textures{ GL_TEXTURE_2D, 1 };
+  gl::ObjectPool m_Framebuffers{ gl::ObjectType::Framebuffer, 1 };
+  gl::Texture m_Colour{ m_Textures };
+  gl::Framebuffer m_Framebuffer{ m_Framebuffers };
+  GLsizei m_Size;
+  // GL_RED or GL_RGBA, the channels ReadPixels returns
+  GLenum m_Format;
+
+public:
+  // internal_format is GL_R8 or GL_RGBA8
+  RenderTarget(GLsizei size, GLenum internal_format)
+    : m_Size(size), m_Format(internal_format == GL_R8 ? GL_RED : GL_RGBA)
+  {
+    m_Colour.Storage2D(1, internal_format, size, size);
+    m_Framebuffer.AttachTexture(GL_COLOR_ATTACHMENT0, m_Colour);
+    m_Framebuffer.Bind();
+    glViewport(0, 0, size, size);
+  }
+  RenderTarget(RenderTarget const &) = delete;
+  RenderTarget(RenderTarget &&) = delete;
+  auto operator=(RenderTarget const &) -> RenderTarget & = delete;
+  auto operator=(RenderTarget &&) -> RenderTarget & = delete;
+  ~RenderTarget() { glBindFramebuffer(GL_FRAMEBUFFER, 0); }
+
+  // Clears to transparent black
+  void Clear() const noexcept
+  {
+    glClearColor(0.0F, 0.0F, 0.0F, 0.0F);
+    glClear(GL_COLOR_BUFFER_BIT);
+  }
+  // One byte per channel, rows from the bottom up
+  [[nodiscard]] auto ReadPixels() const -> std::vector<std::uint8_t>
+  {
+    auto const Channels = m_Format == GL_RED ? 1 : 4;
+    std::vector<std::uint8_t> Pixels(
+      static_cast<std::size_t>(Channels * m_Size * m_Size));
+    glGetTextureImage(m_Colour.GetName(),
+      0,
+      m_Format,
+      GL_UNSIGNED_BYTE,
+      static_cast<GLsizei>(Pixels.size()),
+      Pixels.data());
+    return Pixels;
+  }
+};
+
+// Makes the current context look like OpenGL 4.2 while it lives, to test
+// fallbacks on a 4.5 context: the 4.3 and 4.5 version flags read false and
+// the entry points the fallbacks must avoid are null, so reaching one
+// crashes the test instead of passing unnoticed.
+class LegacyContextScope
+{
+  template<typename T> class Override
+  {
+    T &m_Target;
+    T m_Saved;
+
+  public:
+    Override(T &target, T value)
+      : m_Target(target), m_Saved(std::exchange(target, value))
+    {}
+    Override(Override const &) = delete;
+    Override(Override &&) = delete;
+    auto operator=(Override const &) -> Override & = delete;
+    auto operator=(Override &&) -> Override & = delete;
+    ~Override() { m_Target = m_Saved; }
+  };
+
+  Override<int> m_Version43{ GLAD_GL_VERSION_4_3, 0 };
+  Override<int> m_Version45{ GLAD_GL_VERSION_4_5, 0 };
+  Override<PFNGLMULTIDRAWARRAYSINDIRECTPROC> m_MultiDraw{
+    glMultiDrawArraysIndirect,
+    nullptr
+  };
+  Override<PFNGLCREATEVERTEXARRAYSPROC> m_CreateVertexArrays{
+    glCreateVertexArrays,
+    nullptr
+  };
+  Override<PFNGLCREATEBUFFERSPROC> m_CreateBuffers{ glCreateBuffers, nullptr };
+  Override<PFNGLNAMEDBUFFERSTORAGEPROC> m_BufferStorage{
+    glNamedBufferStorage,
+    nullptr
+  };
+  Override<PFNGLNAMEDBUFFERSUBDATAPROC> m_BufferSubData{
+    glNamedBufferSubData,
+    nullptr
+  };
+  Override<PFNGLVERTEXARRAYELEMENTBUFFERPROC> m_ElementBuffer{
+    glVertexArrayElementBuffer,
+    nullptr
+  };
+  Override<PFNGLVERTEXARRAYVERTEXBUFFERPROC> m_VertexBuffer{
+    glVertexArrayVertexBuffer,
+    nullptr
+  };
+  Override<PFNGLVERTEXARRAYATTRIBFORMATPROC> m_AttribFormat{
+    glVertexArrayAttribFormat,
+    nullptr
+  };
+};
+}// namespace renderer::test
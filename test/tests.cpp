@@ -2,12 +2,57 @@
 // NOLINTNEXTLINE
 #include <glad/glad.h>
 
+#include <renderer/buffer/bufferArena.hpp>
+#include <renderer/buffer/compactVertex.hpp>
+#include <renderer/buffer/streamingBuffer.hpp>
+#include <renderer/colour/colourConversion.hpp>
+#include <renderer/colour/spectrum.hpp>
 #include <renderer/drawer/drawer.hpp>
+#include <renderer/drawer/drawerQueue.hpp>
+// NOLINTNEXTLINE
+#include <GLFW/glfw3.h>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <optional>
 #include <renderer/error/error.hpp>
+#include <renderer/object/glObject.hpp>
+#include <renderer/plot/polylineBatch.hpp>
+#include <renderer/point/markerRenderer.hpp>
+#include <renderer/point/point.hpp>
+#include <renderer/point/pointCloud.hpp>
+#include <renderer/shader/computeProgram.hpp>
+#include <renderer/shader/pendingProgram.hpp>
+#include <renderer/shader/preprocessor.hpp>
+#include <renderer/shader/programCache.hpp>
+#include <renderer/shader/programPermutations.hpp>
+#include <renderer/shader/programPipeline.hpp>
+#include <renderer/shader/shader.hpp>
+#include <renderer/shape/polygonBatch.hpp>
+#include <renderer/utils/fileWatcher.hpp>
+#include <renderer/vector/vectorExpression.hpp>
 #include <spdlog/common.h>
+#include <span>
+#include <stdexcept>
 #include <string>
 #include <string_view>
+#include <thread>
+#include <tuple>
+#include <type_traits>
 #include <utility>
+#include <vector>
+
+#include "hiddenContext.hpp"
+
+using renderer::test::HiddenContext;
+
 TEST_CASE("Error excceptions", "[std::exception]")
 {
   REQUIRE(
@@ -49,39 +94,61 @@ TEST_CASE("Drawer works with void return", "[Drawer]")
   REQUIRE((CallCount == 2));
 }
 
-TEST_CASE("Drawer copy and move constructors/assignment", "[Drawer]")
+TEST_CASE("Drawer move constructors/assignment", "[Drawer]")
 {
+  STATIC_REQUIRE(
+    (!std::is_copy_constructible_v<renderer::drawer::Drawer<void(int)>>));
+  STATIC_REQUIRE(
+    (!std::is_copy_assignable_v<renderer::drawer::Drawer<void(int)>>));
   int Result = 0;
   renderer::drawer::Drawer<void(int)> Orig([&](int x) { Result = x + 1; });
-  renderer::drawer::Drawer<void(int)> Copy = Orig;
   renderer::drawer::Drawer<void(int)> Moved = std::move(Orig);
 
-  // NOLINTNEXTLINE
-  Copy.Draw(10);
-  REQUIRE((Result == 11));
-
   // NOLINTNEXTLINE
   Moved.Draw(12);
   REQUIRE((Result == 13));
 
-  renderer::drawer::Drawer<void(int)> Assigned([&](int x) { Result = x - 1; });
-  Assigned = Copy;
+  renderer::drawer::Drawer<void(int)> MoveAssigned(
+    [&](int x) { Result = x * 2; });
+  MoveAssigned = std::move(Moved);
   // NOLINTNEXTLINE
-  Assigned.Draw(20);
+  MoveAssigned.Draw(20);
   REQUIRE((Result == 21));
+}
 
-  renderer::drawer::Drawer<void(int)> MoveAssigned(
-    [&](int x) { Result = x * 2; });
-  MoveAssigned = std::move(Copy);
-  MoveAssigned.Draw(3);
-  REQUIRE((Result == 4));
+TEST_CASE("Drawer stores move-only strategies inline", "[Drawer]")
+{
+  auto Value = std::make_unique<int>(4);
+  renderer::drawer::Drawer<int(int)> Owning(
+    [Value = std::move(Value)](int x) { return *Value * x; });
+  REQUIRE((Owning.Draw(3) == 12));
+
+  renderer::drawer::Drawer<int(int)> Moved = std::move(Owning);
+  REQUIRE((Moved.Draw(5) == 20));
+
+  // NOLINTNEXTLINE
+  std::array<int, 16> Large{ 1, 2, 3 };
+  renderer::drawer::Drawer<int(), sizeof(Large)> LargeDrawer(
+    [Large]() { return Large[2]; });
+  REQUIRE((LargeDrawer.Draw() == 3));
+}
+
+TEST_CASE("Drawer forwards reference parameters", "[Drawer]")
+{
+  std::string Log;
+  renderer::drawer::Drawer<void(std::string &, std::string const &)> Appender(
+    [](std::string &out, std::string const &text) { out += text; });
+  Appender.Draw(Log, "ray");
+  Appender.Draw(Log, "s");
+  REQUIRE((Log == "rays"));
 }
 TEST_CASE("StaticDrawerSet works with single drawer", "[StaticDrawerSet]")
 {
   int CallCount = 0;
-  renderer::drawer::Drawer<void()> const SingleDrawer([&]() { CallCount++; });
+  renderer::drawer::Drawer<void()> SingleDrawer([&]() { CallCount++; });
 
-  renderer::drawer::StaticDrawerSet<void(), 1> DrawerSet{ SingleDrawer };
+  renderer::drawer::StaticDrawerSet<void(), 1> DrawerSet{ std::move(
+    SingleDrawer) };
   DrawerSet.Draw();
   REQUIRE((CallCount == 1));
 
@@ -96,9 +163,6 @@ TEST_CASE("renderer::drawer::StaticDrawerSet works with multiple drawers",
   int CallCount2 = 0;
   int CallCount3 = 0;
 
-  renderer::drawer::Drawer<void()> const Drawer1([&]() { CallCount1++; });
-  renderer::drawer::Drawer<void()> const Drawer2([&]() { CallCount2++; });
-  renderer::drawer::Drawer<void()> const Drawer3([&]() { CallCount3++; });
   using Drawer = renderer::drawer::Drawer<void()>;
 
   renderer::drawer::StaticDrawerSet<void(), 3> DrawerSet{
@@ -126,13 +190,14 @@ TEST_CASE("renderer::drawer::StaticDrawerSet works with parameters",
   int Result1 = 0;
   int Result2 = 0;
 
-  renderer::drawer::Drawer<void(int, int)> const AddDrawer(
+  renderer::drawer::Drawer<void(int, int)> AddDrawer(
     [&](int x, int y) { Result1 = x + y; });
-  renderer::drawer::Drawer<void(int, int)> const MultiplyDrawer(
+  renderer::drawer::Drawer<void(int, int)> MultiplyDrawer(
     [&](int x, int y) { Result2 = x * y; });
 
-  renderer::drawer::StaticDrawerSet<void(int, int), 2> DrawerSet{ AddDrawer,
-    MultiplyDrawer };
+  renderer::drawer::StaticDrawerSet<void(int, int), 2> DrawerSet{
+    std::move(AddDrawer), std::move(MultiplyDrawer)
+  };
 
   DrawerSet.Draw(3, 4);
 
@@ -153,15 +218,15 @@ TEST_CASE("renderer::drawer::StaticDrawerSet works with single parameter",
   int DoubleResult = 0;
   int CubeResult = 0;
 
-  renderer::drawer::Drawer<void(int)> const SquareDrawer(
+  renderer::drawer::Drawer<void(int)> SquareDrawer(
     [&](int x) { SquareResult = x * x; });
-  renderer::drawer::Drawer<void(int)> const DoubleDrawer(
+  renderer::drawer::Drawer<void(int)> DoubleDrawer(
     [&](int x) { DoubleResult = x * 2; });
-  renderer::drawer::Drawer<void(int)> const CubeDrawer(
+  renderer::drawer::Drawer<void(int)> CubeDrawer(
     [&](int x) { CubeResult = x * x * x; });
 
   renderer::drawer::StaticDrawerSet<void(int), 3> DrawerSet{
-    SquareDrawer, DoubleDrawer, CubeDrawer
+    std::move(SquareDrawer), std::move(DoubleDrawer), std::move(CubeDrawer)
   };
 
   DrawerSet.Draw(3);
@@ -183,13 +248,14 @@ TEST_CASE("renderer::drawer::StaticDrawerSet works with mixed operations",
   std::string LogOutput;
   int Counter = 0;
 
-  renderer::drawer::Drawer<void(int)> const LogDrawer(
+  renderer::drawer::Drawer<void(int)> LogDrawer(
     [&](int x) { LogOutput += "Logged: " + std::to_string(x) + " "; });
-  renderer::drawer::Drawer<void(int)> const CountDrawer(
+  renderer::drawer::Drawer<void(int)> CountDrawer(
     [&](int x) { Counter += x; });
 
-  renderer::drawer::StaticDrawerSet<void(int), 2> DrawerSet{ LogDrawer,
-    CountDrawer };
+  renderer::drawer::StaticDrawerSet<void(int), 2> DrawerSet{
+    std::move(LogDrawer), std::move(CountDrawer)
+  };
 
   // NOLINTNEXTLINE
   DrawerSet.Draw(5);
@@ -203,3 +269,1342 @@ TEST_CASE("renderer::drawer::StaticDrawerSet works with mixed operations",
   REQUIRE((LogOutput == "Logged: 5 Logged: 10 "));
   REQUIRE((Counter == 15));
 }
+
+TEST_CASE("renderer::drawer::StaticDrawerPipeline draws in order",
+  "[StaticDrawerPipeline]")
+{
+  std::string Order;
+  renderer::drawer::Drawer<void(int)> ErasedDrawer(
+    [&](int x) { Order += "b" + std::to_string(x); });
+
+  auto Pipeline = renderer::drawer::MakeStaticDrawerPipeline<void(int)>(
+    [&](int x) { Order += "a" + std::to_string(x); },
+    std::move(ErasedDrawer),
+    [&](int x) { Order += "c" + std::to_string(x); });
+  STATIC_REQUIRE((decltype(Pipeline)::kNumber == 3));
+
+  Pipeline.Draw(1);
+  REQUIRE((Order == "a1b1c1"));
+  Pipeline.Draw(2);
+  REQUIRE((Order == "a1b1c1a2b2c2"));
+}
+
+TEST_CASE("renderer::drawer::StaticDrawerPipeline collects return values",
+  "[StaticDrawerPipeline]")
+{
+  auto Pipeline = renderer::drawer::MakeStaticDrawerPipeline<int(int, int)>(
+    [](int x, int y) { return x + y; }, [](int x, int y) { return x * y; });
+
+  REQUIRE((Pipeline.Draw(3, 4) == std::array{ 7, 12 }));
+}
+
+namespace {
+struct RecordingBinder
+{
+  std::vector<std::string> *Calls;
+  void BindProgram(GLuint program) const
+  {
+    Calls->push_back("program " + std::to_string(program));
+  }
+  void BindVertexArray(GLuint vertex_array) const
+  {
+    Calls->push_back("vao " + std::to_string(vertex_array));
+  }
+  void BindTexture(GLuint unit, GLuint texture) const
+  {
+    Calls->push_back(
+      "texture " + std::to_string(unit) + " " + std::to_string(texture));
+  }
+  void SetBlendMode(renderer::drawer::BlendMode /*mode*/) const {}
+};
+}// namespace
+
+TEST_CASE("renderer::drawer::StateSortedDrawerQueue sorts and skips binds",
+  "[StateSortedDrawerQueue]")
+{
+  using renderer::drawer::BlendMode;
+  std::vector<std::string> Calls;
+  renderer::drawer::StateSortedDrawerQueue<void(), RecordingBinder> Queue(
+    RecordingBinder{ &Calls });
+
+  Queue.Submit({ .Blend = BlendMode::Alpha, .Program = 1, .VertexArray = 1 },
+    [&]() { Calls.emplace_back("blended"); });
+  Queue.Submit({ .Program = 2, .VertexArray = 5 },
+    [&]() { Calls.emplace_back("lens"); });
+  Queue.Submit({ .Program = 1, .VertexArray = 3 },
+    [&]() { Calls.emplace_back("ray"); });
+  Queue.Submit({ .Program = 1, .VertexArray = 3 },
+    [&]() { Calls.emplace_back("plot"); });
+  Queue.Draw();
+
+  REQUIRE((Calls
+           == std::vector<std::string>{ "program 1",
+             "vao 3",
+             "ray",
+             "plot",
+             "program 2",
+             "vao 5",
+             "lens",
+             "program 1",
+             "vao 1",
+             "blended" }));
+  auto const &Statistics = Queue.GetStatistics();
+  REQUIRE((Statistics.DrawerCalls == 4));
+  REQUIRE((Statistics.ProgramBinds == 3));
+  REQUIRE((Statistics.VertexArrayBinds == 3));
+  REQUIRE((Statistics.BlendChanges == 2));
+
+  Calls.clear();
+  Queue.Clear();
+  Queue.Draw();
+  REQUIRE((Calls.empty()));
+  REQUIRE((Queue.GetStatistics().DrawerCalls == 0));
+}
+
+TEST_CASE("renderer::drawer::StateSortedDrawerQueue binds only used units",
+  "[StateSortedDrawerQueue]")
+{
+  std::vector<std::string> Calls;
+  renderer::drawer::StateSortedDrawerQueue<void(), RecordingBinder> Queue(
+    RecordingBinder{ &Calls });
+
+  Queue.Submit({ .Program = 1, .VertexArray = 1, .Textures = { 0, 7 } },
+    [&]() { Calls.emplace_back("mirror"); });
+  Queue.Submit({ .Program = 1, .VertexArray = 1, .Textures = { 4, 7 } },
+    [&]() { Calls.emplace_back("lens"); });
+  Queue.Submit(
+    { .Program = 1, .VertexArray = 1 }, [&]() { Calls.emplace_back("ray"); });
+  Queue.Draw();
+
+  // Unit 1 keeps texture 7 across the draws, and no unit gets texture 0
+  REQUIRE((Calls
+           == std::vector<std::string>{ "program 1",
+             "vao 1",
+             "ray",
+             "texture 1 7",
+             "mirror",
+             "texture 0 4",
+             "lens" }));
+  REQUIRE((Queue.GetStatistics().TextureBinds == 2));
+}
+
+TEST_CASE("Uniform type compatibility",
+  "[renderer::gl::IsUniformTypeCompatible]")
+{
+  using renderer::gl::IsUniformTypeCompatible;
+  REQUIRE(IsUniformTypeCompatible(GL_FLOAT_VEC3, GL_FLOAT, 3));
+  REQUIRE(IsUniformTypeCompatible(GL_UNSIGNED_INT, GL_UNSIGNED_INT, 1));
+  REQUIRE(IsUniformTypeCompatible(GL_DOUBLE_VEC4, GL_DOUBLE, 4));
+  REQUIRE(IsUniformTypeCompatible(GL_BOOL_VEC2, GL_INT, 2));
+  REQUIRE(IsUniformTypeCompatible(GL_SAMPLER_2D, GL_INT, 1));
+  REQUIRE_FALSE(IsUniformTypeCompatible(GL_FLOAT_VEC3, GL_FLOAT, 4));
+  REQUIRE_FALSE(IsUniformTypeCompatible(GL_FLOAT, GL_INT, 1));
+  REQUIRE_FALSE(IsUniformTypeCompatible(GL_BOOL, GL_DOUBLE, 1));
+  REQUIRE_FALSE(IsUniformTypeCompatible(GL_SAMPLER_2D, GL_FLOAT, 1));
+}
+TEST_CASE("Uniform type enum to str", "[renderer::gl::GetUniformTypeString]")
+{
+  REQUIRE((renderer::gl::GetUniformTypeString(GL_FLOAT_VEC3)
+           == std::string_view{ "vec3" }));
+  REQUIRE((renderer::gl::GetUniformTypeString(GL_UNSIGNED_INT_VEC2)
+           == std::string_view{ "uvec2" }));
+  REQUIRE(
+    (renderer::gl::GetUniformTypeString(0) == std::string_view{ "Unknown" }));
+}
+
+TEST_CASE("FileWatcher reads files written after it started",
+  "[renderer::utils::FileWatcher]")
+{
+  auto const Directory =
+    std::filesystem::temp_directory_path() / "renderer-file-watcher-test";
+  std::filesystem::remove_all(Directory);
+  std::filesystem::create_directories(Directory);
+  renderer::utils::FileWatcher Watcher(
+    Directory, std::chrono::milliseconds(10));
+
+  // The watch is set up on the watcher's thread, so keep rewriting the file
+  // until a change comes through
+  std::vector<renderer::utils::ChangedFile> Changes;
+  for (int Attempt = 0; Attempt < 50 && Changes.empty(); ++Attempt) {
+    std::ofstream(Directory / "lens.frag.glsl") << "void main() {}";
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    Changes = Watcher.TakeChanges();
+  }
+  REQUIRE((Changes.size() == 1));
+  REQUIRE((Changes[0].Path == Directory / "lens.frag.glsl"));
+  REQUIRE((Changes[0].Contents == "void main() {}"));
+  REQUIRE((Watcher.TakeChanges().empty()));
+  std::filesystem::remove_all(Directory);
+}
+
+TEST_CASE("Shader defines are keyed independently of order",
+  "[renderer::gl::ShaderDefines]")
+{
+  using renderer::gl::ShaderDefines;
+  ShaderDefines const Dispersive{ { "DISPERSIVE" }, { "SAMPLES", "8" } };
+  ShaderDefines Reordered;
+  Reordered.Set("SAMPLES", "8").Set("DISPERSIVE");
+  REQUIRE((Dispersive.GetKey() == Reordered.GetKey()));
+  REQUIRE((Dispersive == Reordered));
+  REQUIRE((Dispersive.Get()[0].Name == "DISPERSIVE"));
+  Reordered.Set("SAMPLES", "16");
+  REQUIRE((Dispersive.GetKey() != Reordered.GetKey()));
+  REQUIRE_FALSE((Dispersive == Reordered));
+  Reordered.Unset("SAMPLES").Unset("DISPERSIVE");
+  REQUIRE((Reordered.GetKey() == ShaderDefines{}.GetKey()));
+}
+
+TEST_CASE("Shader preprocessor injects defines and expands includes",
+  "[renderer::gl::PreprocessShader]")
+{
+  using renderer::gl::PreprocessShader;
+  auto Resolve = [](std::string_view name) -> std::optional<std::string> {
+    if (name == "common.glsl") { return "float Square(float x);"; }
+    if (name == "loop.glsl") { return "#include \"loop.glsl\""; }
+    return std::nullopt;
+  };
+  REQUIRE((PreprocessShader("// Lens\n#version 330 core\n"
+                            "#include \"common.glsl\"\n"
+                            "#include \"common.glsl\"\nvoid main() {}\n",
+             { { "DISPERSIVE" } },
+             Resolve)
+           == "// Lens\n#version 330 core\n#define DISPERSIVE 1\n"
+              "#line 3 0\n#line 1 1\nfloat Square(float x);\n#line 4 0\n"
+              "#line 5 0\nvoid main() {}\n"));
+  REQUIRE((PreprocessShader("void main() {}", {})
+           == "#line 1 0\nvoid main() {}\n"));
+  REQUIRE_THROWS_AS(
+    PreprocessShader("#include \"missing.glsl\"", {}, Resolve),
+    renderer::CompilationError);
+  REQUIRE_THROWS_AS(PreprocessShader("#include \"loop.glsl\"", {}, Resolve),
+    renderer::CompilationError);
+}
+
+TEST_CASE("ComputeProgram dispatches over a storage buffer",
+  "[renderer::gl::ComputeProgram][gl]")
+{
+  HiddenContext const Context;
+  if (!Context) { SKIP("No OpenGL 4.5 context available"); }
+
+  renderer::gl::ComputeProgram Doubler(R"glsl(#version 450 core
+    layout(local_size_x = 64) in;
+    layout(std430, binding = 0) buffer Values { float Data[]; };
+    uniform uint uCount;
+    void main()
+    {
+      uint Index = gl_GlobalInvocationID.x;
+      if (Index < uCount) { Data[Index] *= 2.0; }
+    })glsl");
+  REQUIRE((Doubler.GetLocalSize() == renderer::gl::DispatchSize{ 64, 1, 1 }));
+
+  std::vector<float> Values(100);
+  for (std::size_t Index = 0; Index < Values.size(); ++Index) {
+    Values[Index] = static_cast<float>(Index);
+  }
+  auto const Bytes = static_cast<GLsizeiptr>(Values.size() * sizeof(float));
+  GLuint Buffer{};
+  glCreateBuffers(1, &Buffer);
+  glNamedBufferStorage(Buffer, Bytes, Values.data(), 0);
+  renderer::gl::ComputeProgram::BindStorageBuffer(0, Buffer);
+  Doubler.GetProgram().SetUniform<1, unsigned int>("uCount", Values.size());
+  Doubler.DispatchInvocations(
+    { static_cast<GLuint>(Values.size()) }, GL_BUFFER_UPDATE_BARRIER_BIT);
+
+  std::vector<float> Results(Values.size());
+  glGetNamedBufferSubData(Buffer, 0, Bytes, Results.data());
+  glDeleteBuffers(1, &Buffer);
+  REQUIRE((Results[1] == 2.0F));
+  REQUIRE((Results[99] == 198.0F));
+}
+
+TEST_CASE("StreamingBuffer cycles through fenced regions",
+  "[renderer::gl::StreamingBuffer][gl]")
+{
+  HiddenContext const Context;
+  if (!Context) { SKIP("No OpenGL 4.5 context available"); }
+
+  renderer::gl::StreamingBuffer Stream(3 * sizeof(float), 3);
+  REQUIRE((Stream.GetRegionSize()
+           == renderer::gl::StreamingBuffer::kRegionAlignment));
+  std::vector<std::size_t> Offsets;
+  for (int Frame = 0; Frame < 5; ++Frame) {
+    auto Region = Stream.BeginRegion<float>();
+    REQUIRE((Region.size() >= 3));
+    Region[0] = static_cast<float>(Frame);
+    Offsets.push_back(Stream.GetRegionOffset());
+    Stream.EndRegion();
+  }
+  REQUIRE((Offsets == std::vector<std::size_t>{ 0, 256, 512, 0, 256 }));
+
+  glFinish();
+  float Written{};
+  glGetNamedBufferSubData(Stream.GetBufferID(), 0, sizeof(float), &Written);
+  REQUIRE((Written == 3.0F));
+
+  using renderer::gl::StreamingBuffer;
+  REQUIRE_THROWS_AS(StreamingBuffer(sizeof(float), 0), std::invalid_argument);
+  REQUIRE_THROWS_AS(StreamingBuffer(0), std::invalid_argument);
+  // Far more than any driver will map, so the mapping comes back null
+  constexpr std::size_t kHuge = std::size_t{ 1 } << 50U;
+  REQUIRE_THROWS_AS(StreamingBuffer(kHuge), std::runtime_error);
+  while (glGetError() != GL_NO_ERROR) {}
+}
+
+TEST_CASE("MarkerRenderer expands instanced points into markers",
+  "[renderer::gl::MarkerRenderer][gl]")
+{
+  HiddenContext const Context;
+  if (!Context) { SKIP("No OpenGL 4.5 context available"); }
+
+  static constexpr GLsizei kSize = 16;
+  renderer::test::RenderTarget const Target(kSize, GL_RGBA8);
+
+  renderer::Point2<float> Centre{};
+  Centre.m_ColourOfPoint.Red().Value = 255;// NOLINT
+  std::array Points{ Centre };
+  // Picks up the viewport set above
+  renderer::gl::MarkerRenderer Markers;
+  Markers.Upload(Points);
+  REQUIRE((Markers.GetInstanceCount() == 1));
+
+  auto DrawAndRead = [&](renderer::gl::MarkerShape shape) {
+    Target.Clear();
+    Markers.Draw({ .Shape = shape, .Size = 12.0F });// NOLINT
+    // Red channel of the pixel x, y away from the centre
+    return [Pixels = Target.ReadPixels()](int x, int y) {
+      return Pixels[static_cast<std::size_t>(
+        4 * ((kSize / 2 + y) * kSize + kSize / 2 + x))];
+    };
+  };
+  using renderer::gl::MarkerShape;
+  auto const Square = DrawAndRead(MarkerShape::Square);
+  REQUIRE((Square(0, 0) == 255));
+  REQUIRE((Square(-5, -5) == 255));
+  REQUIRE((Square(7, 0) == 0));
+  auto const Circle = DrawAndRead(MarkerShape::Circle);
+  REQUIRE((Circle(4, 0) == 255));
+  REQUIRE((Circle(-5, -5) == 0));
+  auto const Cross = DrawAndRead(MarkerShape::Cross);
+  REQUIRE((Cross(5, 0) == 255));
+  REQUIRE((Cross(0, -5) == 255));
+  REQUIRE((Cross(3, 3) == 0));
+  // Twice the pixels across halves the size of the markers in clip space
+  Markers.SetViewport(2 * kSize, 2 * kSize);
+  auto const Small = DrawAndRead(MarkerShape::Square);
+  REQUIRE((Small(-2, -2) == 255));
+  REQUIRE((Small(-5, -5) == 0));
+}
+
+TEST_CASE("PolylineBatch packs paths back to back",
+  "[renderer::gl::PolylineBatch]")
+{
+  using renderer::gl::DrawArraysIndirectCommand;
+  using renderer::gl::kPrimitiveRestartIndex;
+  using Position = renderer::Vector2<float>;
+  renderer::gl::PolylineBatch<Position> Batch;
+  Batch.Add(std::vector<Position>(3));
+  Batch.Add(std::vector<Position>(1));
+  Batch.Add(std::vector<Position>(2));
+  REQUIRE((Batch.GetPolylineCount() == 2));
+  REQUIRE((Batch.GetVertices().size() == 5));
+  REQUIRE((Batch.GetCommands()[0] == DrawArraysIndirectCommand{ 3, 1, 0, 0 }));
+  REQUIRE((Batch.GetCommands()[1] == DrawArraysIndirectCommand{ 2, 1, 3, 1 }));
+  REQUIRE((Batch.GetRestartIndices()
+           == std::vector<GLuint>{ 0, 1, 2, kPrimitiveRestartIndex, 3, 4 }));
+  Batch.Clear();
+  REQUIRE(Batch.GetRestartIndices().empty());
+}
+
+TEST_CASE("PolylineRenderer draws a batch with either submission",
+  "[renderer::gl::PolylineRenderer][gl]")
+{
+  HiddenContext const Context;
+  if (!Context) { SKIP("No OpenGL 4.5 context available"); }
+
+  static constexpr GLsizei kSize = 8;
+  renderer::test::RenderTarget const Target(kSize, GL_R8);
+
+  renderer::gl::Program const White(
+    renderer::gl::ShaderUnit<GL_VERTEX_SHADER>(R"glsl(#version 450 core
+      layout(location = 0) in vec2 aPosition;
+      void main() { gl_Position = vec4(aPosition, 0.0, 1.0); })glsl"),
+    renderer::gl::ShaderUnit<GL_FRAGMENT_SHADER>(R"glsl(#version 450 core
+      out vec4 FragColour;
+      void main() { FragColour = vec4(1.0); })glsl"));
+  // Two horizontal lines through pixel rows 2 and 5, the second one drawn
+  // as two segments
+  using Position = renderer::Vector2<float>;
+  renderer::gl::PolylineBatch<Position> Batch;
+  Batch.Add(std::array{ Position{ { -1.0F, -0.375F } },
+    Position{ { 1.0F, -0.375F } } });
+  Batch.Add(std::array{ Position{ { -1.0F, 0.375F } },
+    Position{ { 0.0F, 0.375F } },
+    Position{ { 1.0F, 0.375F } } });
+
+  // Drawers point at the renderer, which therefore stays put
+  STATIC_REQUIRE(
+    !std::is_move_constructible_v<renderer::gl::PolylineRenderer>);
+  using renderer::gl::PolylineSubmission;
+  for (auto const Submission : { PolylineSubmission::MultiDrawIndirect,
+         PolylineSubmission::PrimitiveRestart }) {
+    renderer::gl::PolylineRenderer Lines(Submission);
+    Lines.Upload(Batch);
+    Target.Clear();
+    auto Drawer = Lines.MakeDrawer(White);
+    Drawer.Draw(*glfwGetCurrentContext(), {});
+    auto const Pixels = Target.ReadPixels();
+    auto const Row = [&](std::size_t row) {
+      return std::span(Pixels).subspan(row * kSize, kSize);
+    };
+    // No line joins the end of the first path to the start of the second
+    for (std::size_t Index = 0; Index < kSize; ++Index) {
+      REQUIRE((Row(2)[Index] == 255));
+      REQUIRE((Row(5)[Index] == 255));
+      REQUIRE((Row(3)[Index] == 0));
+      REQUIRE((Row(4)[Index] == 0));
+    }
+  }
+}
+
+TEST_CASE("PolylineRenderer falls back to primitive restart before 4.5",
+  "[renderer::gl::PolylineRenderer][gl]")
+{
+  HiddenContext const Context;
+  if (!Context) { SKIP("No OpenGL 4.5 context available"); }
+
+  static constexpr GLsizei kSize = 8;
+  renderer::test::RenderTarget const Target(kSize, GL_R8);
+  Target.Clear();
+
+  renderer::gl::Program const White(
+    renderer::gl::ShaderUnit<GL_VERTEX_SHADER>(R"glsl(#version 450 core
+      layout(location = 0) in vec2 aPosition;
+      void main() { gl_Position = vec4(aPosition, 0.0, 1.0); })glsl"),
+    renderer::gl::ShaderUnit<GL_FRAGMENT_SHADER>(R"glsl(#version 450 core
+      out vec4 FragColour;
+      void main() { FragColour = vec4(1.0); })glsl"));
+  using Position = renderer::Vector2<float>;
+  renderer::gl::PolylineBatch<Position> Batch;
+  Batch.Add(std::array{ Position{ { -1.0F, -0.375F } },
+    Position{ { 1.0F, -0.375F } } });
+  Batch.Add(std::array{ Position{ { -1.0F, 0.375F } },
+    Position{ { 1.0F, 0.375F } } });
+  {
+    renderer::test::LegacyContextScope const Legacy;
+    renderer::gl::PolylineRenderer Lines;
+    REQUIRE((Lines.GetSubmission()
+             == renderer::gl::PolylineSubmission::PrimitiveRestart));
+    Lines.Upload(Batch);
+    // A second, larger upload grows the buffers in place
+    Batch.Add(std::array{ Position{ { -1.0F, 0.875F } },
+      Position{ { 1.0F, 0.875F } } });
+    Lines.Upload(Batch);
+    White.Use();
+    Lines.Draw();
+  }
+
+  auto const Pixels = Target.ReadPixels();
+  for (std::size_t Index = 0; Index < kSize; ++Index) {
+    REQUIRE((Pixels[2 * kSize + Index] == 255));
+    REQUIRE((Pixels[5 * kSize + Index] == 255));
+    REQUIRE((Pixels[7 * kSize + Index] == 255));
+    REQUIRE((Pixels[4 * kSize + Index] == 0));
+  }
+}
+
+TEST_CASE("RangeAllocator reuses and merges freed ranges",
+  "[renderer::gl::RangeAllocator]")
+{
+  renderer::gl::RangeAllocator Ranges(1024);
+  auto const First = Ranges.Allocate(100, 1);
+  auto const Second = Ranges.Allocate(100, 256);
+  auto const Third = Ranges.Allocate(100, 1);
+  REQUIRE((First == 0));
+  REQUIRE((Second == 256));
+  // Best fit: the gap left by aligning Second is smaller than the tail
+  REQUIRE((Third == 100));
+  REQUIRE((Ranges.GetStatistics().FreeBlocks == 2));
+  REQUIRE((Ranges.Allocate(1024, 1) == std::nullopt));
+
+  Ranges.Free(*Second, 100);
+  Ranges.Free(*First, 100);
+  auto Statistics = Ranges.GetStatistics();
+  REQUIRE((Statistics.Used == 100));
+  REQUIRE((Statistics.FreeBlocks == 2));
+  REQUIRE((Statistics.LargestFreeBlock == 824));
+  REQUIRE((Statistics.GetFragmentation() > 0.0));
+
+  Ranges.Free(*Third, 100);
+  Statistics = Ranges.GetStatistics();
+  REQUIRE((Statistics.Allocations == 0));
+  REQUIRE((Statistics.FreeBlocks == 1));
+  REQUIRE((Statistics.GetFragmentation() == 0.0));
+}
+
+TEST_CASE("BufferArena shares pages between allocations",
+  "[renderer::gl::BufferArena][gl]")
+{
+  HiddenContext const Context;
+  if (!Context) { SKIP("No OpenGL 4.5 context available"); }
+
+  renderer::gl::BufferArena Arena(4096);
+  std::array const Outline{ 1.0F, 2.0F, 3.0F };
+  auto const Lens = Arena.Allocate(std::as_bytes(std::span(Outline)));
+  auto const Axes = Arena.Allocate(64);
+  REQUIRE((Lens.Buffer == Axes.Buffer));
+  REQUIRE((Axes.Offset
+           % static_cast<GLintptr>(renderer::gl::BufferArena::kDefaultAlignment)
+           == 0));
+  auto const Large = Arena.Allocate(8192);
+  REQUIRE((Large.Buffer != Lens.Buffer));
+  REQUIRE((Arena.GetPageCount() == 2));
+
+  std::array<float, 3> ReadBack{};
+  glGetNamedBufferSubData(
+    Lens.Buffer, Lens.Offset, sizeof(ReadBack), ReadBack.data());
+  REQUIRE((ReadBack == Outline));
+
+  Arena.Free(Axes);
+  Arena.Free(Large);
+  auto const Statistics = Arena.GetStatistics();
+  REQUIRE((Statistics.Capacity == 4096 + 8192));
+  REQUIRE((Statistics.Allocations == 1));
+  REQUIRE_THROWS_AS(Arena.Allocate(0), std::invalid_argument);
+}
+
+TEST_CASE("GL object handles come from batched pools",
+  "[renderer::gl::ObjectPool][gl]")
+{
+  HiddenContext const Context;
+  if (!Context) { SKIP("No OpenGL 4.5 context available"); }
+
+  renderer::gl::ObjectPool Buffers(renderer::gl::ObjectType::Buffer, 4);
+  renderer::gl::Buffer Vertices(Buffers);
+  REQUIRE((Buffers.GetAvailable() == 3));
+  REQUIRE(glIsBuffer(Vertices.GetName()) == GL_TRUE);
+
+  std::array const Data{ 1.0F, 2.0F, 3.0F, 4.0F };
+  Vertices.Storage(sizeof(Data), GL_DYNAMIC_STORAGE_BIT);
+  Vertices.SubData(0, std::as_bytes(std::span(Data)));
+  REQUIRE((Vertices.GetSize() == sizeof(Data)));
+  std::array<float, 4> ReadBack{};
+  glGetNamedBufferSubData(
+    Vertices.GetName(), 0, sizeof(ReadBack), ReadBack.data());
+  REQUIRE((ReadBack == Data));
+
+  auto const Name = Vertices.GetName();
+  auto Moved = std::move(Vertices);
+  REQUIRE_FALSE(Vertices);// NOLINT(bugprone-use-after-move)
+  REQUIRE((Moved.GetName() == Name));
+  Moved.Reset();
+  Buffers.Flush();
+  REQUIRE(glIsBuffer(Name) == GL_FALSE);
+
+  renderer::gl::ObjectPool Textures(GL_TEXTURE_2D, 2);
+  renderer::gl::ObjectPool Framebuffers(
+    renderer::gl::ObjectType::Framebuffer);
+  renderer::gl::Texture const Target(Textures);
+  Target.Storage2D(1, GL_RGBA8, 4, 4);
+  renderer::gl::Framebuffer const Offscreen(Framebuffers);
+  Offscreen.AttachTexture(GL_COLOR_ATTACHMENT0, Target);
+  REQUIRE(Offscreen.IsComplete());
+}
+
+TEST_CASE("Vector expressions match element-wise loops",
+  "[renderer::Vector]")
+{
+  // Runtime evaluation goes through SIMD packs where available
+  renderer::Vector4<float> const A{ { 0.1F, -2.5F, 3.0F, 1e-3F } };
+  renderer::Vector4<float> const B{ { 7.0F, 0.25F, -1.5F, 4.0F } };
+  renderer::Vector4<float> const C{ { 1.0F, 2.0F, 3.0F, 4.0F } };
+  renderer::Vector4<float> Fused = A * 3.0F + B / C - -B;
+  for (std::size_t Index = 0; Index < 4; ++Index) {
+    auto const [a, b, c] =
+      std::tuple{ A.m_Values[Index], B.m_Values[Index], C.m_Values[Index] };
+    REQUIRE((Fused.m_Values[Index] == a * 3.0F + b / c - -b));
+  }
+  Fused += C;
+  Fused *= 2;
+  REQUIRE((Fused.m_Values[3] == ((1e-3F * 3.0F + 1.0F + 4.0F) + 4.0F) * 2));
+
+  renderer::Vector3<double> const Incident{ { 0.6, -0.8, 0.0 } };
+  renderer::Vector3<double> const Normal{ { 0.0, 1.0, 0.0 } };
+  REQUIRE((renderer::Dot(Incident, Normal) == -0.8));
+  auto const Refracted = renderer::Refract(Incident, Normal, 1.0 / 1.5);
+  REQUIRE(Refracted.has_value());
+  // Snell's law: n1 sin(i) == n2 sin(t)
+  REQUIRE((std::abs(Refracted->m_Values[0] * 1.5 - 0.6) < 1e-12));
+  REQUIRE((std::abs(renderer::Length(*Refracted) - 1.0) < 1e-12));
+}
+
+TEST_CASE("PointCloud stores points as aligned arrays",
+  "[renderer::PointCloud]")
+{
+  std::array<renderer::Point3<float>, 3> Points{};
+  for (std::size_t Index = 0; Index < Points.size(); ++Index) {
+    auto const Value = static_cast<float>(Index);
+    Points[Index].m_PositionVector.m_Values = { Value, 2 * Value, -Value };
+    Points[Index].m_ColourOfPoint.Blue().Value =
+      static_cast<std::uint8_t>(10 * Index);
+  }
+  renderer::PointCloud3<float> Cloud(std::span<renderer::Point3<float> const>{
+    Points });
+  Cloud.PushBack(Points[1]);
+  REQUIRE((Cloud.GetSize() == 4));
+  for (std::size_t Axis = 0; Axis < 3; ++Axis) {
+    auto const Address =
+      reinterpret_cast<std::uintptr_t>(Cloud.GetCoordinates(Axis).data());
+    REQUIRE((Address % renderer::PointCloud3<float>::kAlignment == 0));
+  }
+  REQUIRE((Cloud.GetCoordinates(1)[2] == 4.0F));
+  REQUIRE((Cloud.GetBlues()[3].Value == 10));
+
+  // References write through to the arrays
+  for (auto Point : Cloud.Points()) { Point.Z() += 1.0F; }
+  Cloud[0] = Points[2];
+  renderer::Point3<float> const First = std::as_const(Cloud)[0];
+  REQUIRE((First.m_PositionVector.m_Values == std::array{ 2.0F, 4.0F, -2.0F }));
+  REQUIRE((First.m_ColourOfPoint.Blue().Value == 20));
+  REQUIRE((Cloud[1].Z() == 0.0F));
+
+  Cloud.Transform(renderer::Vector3<float>{ { 2.0F, 1.0F, 1.0F } },
+    renderer::Vector3<float>{ { 0.0F, 0.0F, 5.0F } });
+  REQUIRE((Cloud[1].X() == 2.0F));
+  REQUIRE((Cloud[1].Z() == 5.0F));
+  // A quarter turn about z
+  Cloud.Transform(std::array{ renderer::Vector3<float>{ { 0.0F, -1.0F, 0.0F } },
+                    renderer::Vector3<float>{ { 1.0F, 0.0F, 0.0F } },
+                    renderer::Vector3<float>{ { 0.0F, 0.0F, 1.0F } } },
+    renderer::Vector3<float>{});
+  REQUIRE((Cloud[1].X() == -2.0F));
+  REQUIRE((Cloud[1].Y() == 2.0F));
+}
+
+TEST_CASE("PointCloud references assign and sort like points",
+  "[renderer::PointCloud]")
+{
+  renderer::PointCloud2<float> Cloud;
+  for (std::uint8_t Index = 0; Index < 4; ++Index) {
+    renderer::Point2<float> Point{};
+    // Y runs 3, 2, 1, 0 and green identifies the original slot
+    Point.m_PositionVector.m_Values = { 0.0F, static_cast<float>(3 - Index) };
+    Point.m_ColourOfPoint.Green().Value = Index;
+    Cloud.PushBack(Point);
+  }
+
+  // Assigning one reference to another copies the point and never rebinds
+  Cloud[0] = Cloud[3];
+  REQUIRE((Cloud[0].Y() == 0.0F));
+  REQUIRE((Cloud[0].Green().Value == 3));
+  auto Second = Cloud[1];
+  Second = std::as_const(Cloud)[2];
+  REQUIRE((Cloud[1].Y() == 1.0F));
+  REQUIRE((Cloud[2].Green().Value == 2));
+  Cloud[0].Y() = 3.0F;
+  Cloud[0].Green().Value = 0;
+  Cloud[1].Y() = 2.0F;
+  Cloud[1].Green().Value = 1;
+
+  swap(Cloud[0], Cloud[3]);
+  REQUIRE((Cloud[0].Green().Value == 3));
+  REQUIRE((Cloud[3].Y() == 3.0F));
+  std::ranges::swap(Cloud[0], Cloud[3]);
+  REQUIRE((Cloud[0].Green().Value == 0));
+
+  auto ByY = [](renderer::Point2<float> const &point) {
+    return point.m_PositionVector.m_Values[1];
+  };
+  using Iterator = std::ranges::iterator_t<decltype(Cloud.Points())>;
+  STATIC_REQUIRE(std::random_access_iterator<Iterator>);
+  STATIC_REQUIRE(std::sortable<Iterator, std::ranges::less, decltype(ByY)>);
+  std::ranges::sort(Cloud.Points(), {}, ByY);
+  for (std::uint8_t Index = 0; Index < 4; ++Index) {
+    REQUIRE((Cloud[Index].Y() == static_cast<float>(Index)));
+    REQUIRE((Cloud[Index].Green().Value == 3 - Index));
+  }
+}
+
+TEST_CASE("PointCloud uploads its arrays without repacking",
+  "[renderer::PointCloud][gl]")
+{
+  HiddenContext const Context;
+  if (!Context) { SKIP("No OpenGL 4.5 context available"); }
+
+  renderer::PointCloud2<float> Cloud;
+  renderer::Point2<float> Point{};
+  Point.m_PositionVector.m_Values = { 1.0F, 2.0F };
+  Point.m_ColourOfPoint.Green().Value = 7;// NOLINT
+  Cloud.PushBack(Point);
+  Cloud.PushBack(Point);
+  REQUIRE((Cloud.GetUploadSize() == 2 * (2 * sizeof(float) + 3)));
+
+  constexpr GLintptr kOffset = 16;
+  GLuint Buffer{};
+  glCreateBuffers(1, &Buffer);
+  glNamedBufferStorage(Buffer,
+    kOffset + static_cast<GLsizeiptr>(Cloud.GetUploadSize()),
+    nullptr,
+    GL_DYNAMIC_STORAGE_BIT);
+  Cloud.Upload(Buffer, kOffset);
+  std::array<float, 4> Coordinates{};
+  glGetNamedBufferSubData(
+    Buffer, kOffset, sizeof(Coordinates), Coordinates.data());
+  REQUIRE((Coordinates == std::array{ 1.0F, 1.0F, 2.0F, 2.0F }));
+  std::array<std::uint8_t, 6> Channels{};
+  glGetNamedBufferSubData(Buffer,
+    kOffset + static_cast<GLintptr>(sizeof(Coordinates)),
+    sizeof(Channels),
+    Channels.data());
+  REQUIRE((Channels == std::array<std::uint8_t, 6>{ 0, 0, 7, 7, 0, 0 }));
+
+  GLuint VertexArray{};
+  glCreateVertexArrays(1, &VertexArray);
+  Cloud.SetupVertexArray(VertexArray, Buffer, kOffset);
+  GLint64 GreenOffset{};
+  glGetVertexArrayIndexed64iv(
+    VertexArray, 3, GL_VERTEX_BINDING_OFFSET, &GreenOffset);
+  REQUIRE((GreenOffset == kOffset + 4 * sizeof(float) + 2));
+  GLint Normalised{};
+  glGetVertexArrayIndexediv(
+    VertexArray, 3, GL_VERTEX_ATTRIB_ARRAY_NORMALIZED, &Normalised);
+  REQUIRE((Normalised == GL_TRUE));
+  glDeleteVertexArrays(1, &VertexArray);
+  glDeleteBuffers(1, &Buffer);
+}
+
+TEST_CASE("Batch colour conversions match the scalar ones",
+  "[renderer::NormaliseChannels]")
+{
+  constexpr std::size_t kCodeCount = 256;
+  // Every code, plus an odd tail past the SIMD blocks
+  std::vector<std::uint8_t> Codes(kCodeCount + 7);
+  for (std::size_t Index = 0; Index < Codes.size(); ++Index) {
+    Codes[Index] = static_cast<std::uint8_t>(Index);
+  }
+  std::vector<float> Normalised(Codes.size());
+  renderer::NormaliseChannels(Codes, Normalised);
+  for (std::size_t Index = 0; Index < Codes.size(); ++Index) {
+    auto const Expected =
+      renderer::RedNormalised(renderer::Red{ Codes[Index] });
+    REQUIRE((std::bit_cast<std::uint32_t>(Normalised[Index])
+             == std::bit_cast<std::uint32_t>(Expected.Value())));
+  }
+
+  // Edge cases, then a sweep over float bit patterns in and around [0, 1]
+  std::vector<float> Values{ -0.0F,
+    -1.0F,
+    1.0F,
+    2.0F,
+    0.5F / 255.0F,
+    std::numeric_limits<float>::quiet_NaN(),
+    std::numeric_limits<float>::infinity(),
+    -std::numeric_limits<float>::infinity() };
+  for (std::uint32_t Bits = 0x3A00'0000; Bits < 0x3F90'0000; Bits += 4099) {
+    Values.push_back(std::bit_cast<float>(Bits));
+  }
+  std::vector<std::uint8_t> Quantised(Values.size());
+  renderer::QuantiseChannels(Values, Quantised);
+  for (std::size_t Index = 0; Index < Values.size(); ++Index) {
+    REQUIRE((Quantised[Index] == renderer::QuantiseChannel(Values[Index])));
+  }
+
+  std::vector<renderer::RGBColour> Colours(kCodeCount);
+  for (std::size_t Index = 0; Index < Colours.size(); ++Index) {
+    Colours[Index].Red().Value = static_cast<std::uint8_t>(Index);
+    Colours[Index].Blue().Value = static_cast<std::uint8_t>(255 - Index);
+  }
+  std::vector<renderer::RBGColourNormalised> Floats(Colours.size());
+  renderer::NormaliseChannels(Colours, Floats);
+  std::vector<renderer::RGBColour> RoundTrip(Colours.size());
+  renderer::QuantiseChannels(Floats, RoundTrip);
+  for (std::size_t Index = 0; Index < Colours.size(); ++Index) {
+    renderer::RBGColourNormalised const Expected(Colours[Index]);
+    REQUIRE((Floats[Index].Red().Value() == Expected.Red().Value()));
+    REQUIRE((Floats[Index].Blue().Value() == Expected.Blue().Value()));
+    REQUIRE((RoundTrip[Index].Red().Value == Colours[Index].Red().Value));
+    REQUIRE((RoundTrip[Index].Blue().Value == Colours[Index].Blue().Value));
+  }
+
+  std::array<std::uint32_t, 5> const Pixels{
+    0xFF00'00FF, 0x8040'2010, 0, 0xFFFF'FFFF, 0x0102'0304
+  };
+  std::array<renderer::Vector4<float>, Pixels.size()> Unpacked{};
+  renderer::UnpackRGBA8(Pixels, Unpacked);
+  REQUIRE((Unpacked[0].m_Values == std::array{ 1.0F, 0.0F, 0.0F, 1.0F }));
+  REQUIRE((Unpacked[1].m_Values[0]
+           == renderer::RedNormalised(renderer::Red{ 0x10 }).Value()));
+  std::array<std::uint32_t, Pixels.size()> Repacked{};
+  renderer::PackRGBA8(Unpacked, Repacked);
+  REQUIRE((Repacked == Pixels));
+}
+
+TEST_CASE("sRGB codes survive a round trip through linear values",
+  "[renderer::EncodeSrgb]")
+{
+  constexpr std::size_t kCodeCount = 256;
+  std::vector<std::uint8_t> Codes(kCodeCount);
+  for (std::size_t Index = 0; Index < Codes.size(); ++Index) {
+    Codes[Index] = static_cast<std::uint8_t>(Index);
+  }
+  std::vector<float> Linear(Codes.size());
+  renderer::DecodeSrgb(Codes, Linear);
+  REQUIRE((Linear.front() == 0.0F));
+  REQUIRE((Linear.back() == 1.0F));
+  REQUIRE(std::ranges::is_sorted(Linear));
+  REQUIRE((std::abs(Linear[128] - renderer::SrgbToLinear(128.0F / 255.0F))
+           < 1e-6F));
+  std::vector<std::uint8_t> Encoded(Codes.size());
+  renderer::EncodeSrgb(Linear, Encoded);
+  REQUIRE((Encoded == Codes));
+
+  REQUIRE(
+    (renderer::EncodeSrgb(std::numeric_limits<float>::quiet_NaN()) == 0));
+  REQUIRE((renderer::EncodeSrgb(-1.0F) == 0));
+  REQUIRE((renderer::EncodeSrgb(2.0F) == 255));
+  REQUIRE((renderer::EncodeSrgb(0.5F)
+           == std::lround(255.0F * renderer::LinearToSrgb(0.5F))));
+}
+
+TEST_CASE("PackPoints matches the scalar conversions",
+  "[renderer::gl::PackPoints]")
+{
+  using renderer::gl::ToHalf;
+  // Odd count and awkward values: rounding ties, overflow, subnormals
+  std::vector<renderer::Point3<float>> Points(7);
+  std::array const Values{ 2049.0F, -65520.0F, 1e-7F, 0.1F, -0.0F, 3.5F };
+  for (std::size_t Index = 0; Index < Points.size(); ++Index) {
+    auto &[Position, Colour] = Points[Index];
+    for (std::size_t Axis = 0; Axis < 3; ++Axis) {
+      Position.m_Values[Axis] = Values[(Index + Axis) % Values.size()];
+    }
+    Colour.Green().Value = static_cast<std::uint8_t>(Index);
+  }
+  std::vector<renderer::gl::CompactPoint3<>> Packed(Points.size());
+  renderer::gl::PackPoints(
+    std::span<renderer::Point3<float> const>(Points), std::span(Packed));
+  for (std::size_t Index = 0; Index < Points.size(); ++Index) {
+    auto const &Position = Packed[Index].Position.m_Values;
+    for (std::size_t Axis = 0; Axis < 3; ++Axis) {
+      REQUIRE((Position[Axis]
+               == ToHalf(Points[Index].m_PositionVector.m_Values[Axis])));
+    }
+    REQUIRE((Position[3] == ToHalf(1.0F)));
+    REQUIRE((Packed[Index].Colour.m_Values[1].Value == Index));
+    REQUIRE((Packed[Index].Colour.m_Values[3].Value == 255));
+  }
+
+  std::vector<renderer::Point2<float>> Flat(3);
+  Flat[2].m_PositionVector.m_Values = { 0.1F, -2049.0F };
+  std::vector<renderer::gl::CompactPoint2<>> PackedFlat(Flat.size());
+  renderer::gl::PackPoints(
+    std::span<renderer::Point2<float> const>(Flat), std::span(PackedFlat));
+  REQUIRE((PackedFlat[2].Position.m_Values[0] == ToHalf(0.1F)));
+  REQUIRE((PackedFlat[2].Position.m_Values[1] == ToHalf(-2049.0F)));
+
+  using renderer::gl::ToSnorm16;
+  std::vector<renderer::gl::CompactPoint3<renderer::gl::Snorm16>> Normalised(
+    Points.size());
+  renderer::gl::PackPoints(
+    std::span<renderer::Point3<float> const>(Points), std::span(Normalised));
+  for (std::size_t Index = 0; Index < Points.size(); ++Index) {
+    for (std::size_t Axis = 0; Axis < 3; ++Axis) {
+      REQUIRE((Normalised[Index].Position.m_Values[Axis]
+               == ToSnorm16(Points[Index].m_PositionVector.m_Values[Axis])));
+    }
+    REQUIRE((Normalised[Index].Position.m_Values[3] == ToSnorm16(1.0F)));
+  }
+}
+
+TEST_CASE("Spectrum lookups interpolate between samples",
+  "[renderer::SpectrumTable]")
+{
+  auto const &Table = renderer::kSpectrumTable;
+  // One sample per nanometre: whole wavelengths hit samples exactly
+  REQUIRE((Table.SampleLinear(380.0F).m_Values == Table.m_Linear[0].m_Values));
+  REQUIRE((Table.SampleLinear(612.0F).m_Values
+           == Table.m_Linear[232].m_Values));
+  REQUIRE(
+    (Table.SampleLinear(780.0F).m_Values == Table.m_Linear.back().m_Values));
+  auto const Between = Table.SampleLinear(612.5F);
+  for (std::size_t Channel = 0; Channel < 3; ++Channel) {
+    auto const Low = Table.m_Linear[232].m_Values[Channel];
+    auto const High = Table.m_Linear[233].m_Values[Channel];
+    REQUIRE((std::abs(Between.m_Values[Channel] - (Low + High) / 2) < 1e-6F));
+  }
+  // Out of range and NaN wavelengths clamp to the ends
+  REQUIRE((Table.SampleLinear(200.0F).m_Values == Table.m_Linear[0].m_Values));
+  REQUIRE((Table.SampleLinear(std::numeric_limits<float>::quiet_NaN()).m_Values
+           == Table.m_Linear[0].m_Values));
+  REQUIRE(
+    (Table.SampleLinear(1e6F).m_Values == Table.m_Linear.back().m_Values));
+
+  std::vector<float> Wavelengths;
+  for (float Wavelength = 350.0F; Wavelength < 800.0F; Wavelength += 7.3F) {
+    Wavelengths.push_back(Wavelength);
+  }
+  std::vector<renderer::Vector3<float>> Linear(Wavelengths.size());
+  std::vector<renderer::RGBColour> Colours(Wavelengths.size());
+  Table.SampleLinear(Wavelengths, Linear);
+  Table.SampleColours(Wavelengths, Colours);
+  for (std::size_t Index = 0; Index < Wavelengths.size(); ++Index) {
+    REQUIRE((Linear[Index].m_Values
+             == Table.SampleLinear(Wavelengths[Index]).m_Values));
+    auto const Single = Table.SampleColour(Wavelengths[Index]);
+    REQUIRE((Colours[Index].Red().Value == Single.Red().Value));
+    REQUIRE((Colours[Index].Green().Value == Single.Green().Value));
+    REQUIRE((Colours[Index].Blue().Value == Single.Blue().Value));
+  }
+  // The encoded table is the sRGB curve applied to the linear one
+  REQUIRE((Table.SampleColour(600.0F).Red().Value
+           == renderer::EncodeSrgb(Table.SampleLinear(600.0F).m_Values[0])));
+}
+
+TEST_CASE("The spectrum table uploads as a 1D texture",
+  "[renderer::SpectrumTable][gl]")
+{
+  HiddenContext const Context;
+  if (!Context) { SKIP("No OpenGL 4.5 context available"); }
+
+  auto const &Table = renderer::kSpectrumTable;
+  renderer::gl::ObjectPool Textures(GL_TEXTURE_1D, 1);
+  renderer::gl::Texture const Spectrum(Textures);
+  Table.Upload(Spectrum);
+  GLint Width = 0;
+  glGetTextureLevelParameteriv(Spectrum.GetName(), 0, GL_TEXTURE_WIDTH, &Width);
+  REQUIRE((Width == static_cast<GLint>(Table.kSamples)));
+  std::vector<renderer::Vector3<float>> ReadBack(Table.kSamples);
+  glGetTextureImage(Spectrum.GetName(),
+    0,
+    GL_RGB,
+    GL_FLOAT,
+    static_cast<GLsizei>(ReadBack.size() * sizeof(ReadBack.front())),
+    ReadBack.data());
+  for (std::size_t Index = 0; Index < ReadBack.size(); ++Index) {
+    REQUIRE((ReadBack[Index].m_Values == Table.m_Linear[Index].m_Values));
+  }
+}
+
+namespace {
+// U shape in [0, 3]^2 with a notch over x in (1, 2), y in (1, 3)
+auto MakeUOutline(float scale, float offset)
+  -> std::vector<renderer::Point2<float>>
+{
+  constexpr std::array<std::array<float, 2>, 8> kCorners{ { { 0, 0 },
+    { 3, 0 },
+    { 3, 3 },
+    { 2, 3 },
+    { 2, 1 },
+    { 1, 1 },
+    { 1, 3 },
+    { 0, 3 } } };
+  std::vector<renderer::Point2<float>> Outline(kCorners.size());
+  for (std::size_t Index = 0; Index < kCorners.size(); ++Index) {
+    for (std::size_t Axis = 0; Axis < 2; ++Axis) {
+      Outline[Index].m_PositionVector.m_Values[Axis] =
+        kCorners[Index][Axis] * scale + offset;
+    }
+    Outline[Index].m_ColourOfPoint.Red().Value = 255;
+  }
+  return Outline;
+}
+}// namespace
+
+TEST_CASE("PolygonBatch shares one index buffer between polygons",
+  "[renderer::gl::PolygonBatch]")
+{
+  renderer::gl::PolygonBatch<float> Batch;
+  Batch.Reserve(3, 15);
+  renderer::Triangle<float> Prism;
+  Batch.Add(Prism);
+  renderer::Polygon<float, 4> Mirror;
+  Mirror.m_Corners[1].m_PositionVector.m_Values = { 1.0F, 0.0F };
+  Mirror.m_Corners[2].m_PositionVector.m_Values = { 1.0F, 1.0F };
+  Mirror.m_Corners[3].m_PositionVector.m_Values = { 0.0F, 1.0F };
+  Batch.Add(Mirror);
+  Batch.Add(std::span<renderer::Point2<float> const>(
+    MakeUOutline(1.0F, 0.0F).data(), 2));
+  auto const Lens = MakeUOutline(1.0F, 0.0F);
+  Batch.Add(std::span<renderer::Point2<float> const>(Lens));
+
+  REQUIRE((Batch.GetPolygonCount() == 3));
+  REQUIRE((Batch.GetVertices().size() == 15));
+  REQUIRE((Batch.GetTriangleCount() == 1 + 2 + 6));
+  auto const Indices = Batch.GetIndices();
+  REQUIRE(std::ranges::equal(
+    Indices.first(9), std::array<GLuint, 9>{ 0, 1, 2, 3, 4, 5, 3, 5, 6 }));
+  // The outline's indices are its own triangulation moved past the others
+  std::vector<std::uint32_t> Scratch(Lens.size());
+  std::vector<std::uint32_t> Local;
+  renderer::Triangulate(std::span<renderer::Point2<float> const>(Lens),
+    std::span(Scratch),
+    std::back_inserter(Local));
+  REQUIRE((Local.size() == 18));
+  for (std::size_t Index = 0; Index < Local.size(); ++Index) {
+    REQUIRE((Indices[9 + Index] == Local[Index] + 7));
+  }
+  Batch.Clear();
+  REQUIRE(Batch.GetIndices().empty());
+  REQUIRE((Batch.GetPolygonCount() == 0));
+}
+
+TEST_CASE("PolygonRenderer fills concave outlines in one draw",
+  "[renderer::gl::PolygonRenderer][gl]")
+{
+  HiddenContext const Context;
+  if (!Context) { SKIP("No OpenGL 4.5 context available"); }
+
+  static constexpr GLsizei kSize = 8;
+  renderer::test::RenderTarget const Target(kSize, GL_R8);
+
+  renderer::gl::Program const Coloured(
+    renderer::gl::ShaderUnit<GL_VERTEX_SHADER>(R"glsl(#version 450 core
+      layout(location = 0) in vec2 aPosition;
+      layout(location = 1) in vec3 aColour;
+      out vec3 vColour;
+      void main() {
+        vColour = aColour;
+        gl_Position = vec4(aPosition, 0.0, 1.0);
+      })glsl"),
+    renderer::gl::ShaderUnit<GL_FRAGMENT_SHADER>(R"glsl(#version 450 core
+      in vec3 vColour;
+      out vec4 FragColour;
+      void main() { FragColour = vec4(vColour, 1.0); })glsl"));
+  // The U fills the whole viewport apart from its notch, which a fan from
+  // the first corner would cover
+  auto const Outline = MakeUOutline(2.0F / 3.0F, -1.0F);
+  renderer::gl::PolygonBatch<float> Batch;
+  Batch.Add(std::span<renderer::Point2<float> const>(Outline));
+  // Drawers keep the renderer's address, so it cannot be moved
+  STATIC_REQUIRE(!std::is_move_constructible_v<renderer::gl::PolygonRenderer>);
+  renderer::gl::PolygonRenderer Polygons;
+  Polygons.Upload(Batch);
+  REQUIRE((Polygons.GetIndexCount() == 18));
+
+  Target.Clear();
+  auto Drawer = Polygons.MakeDrawer(Coloured);
+  Drawer.Draw(*glfwGetCurrentContext(), {});
+  auto const Pixels = Target.ReadPixels();
+  auto const Pixel = [&](std::size_t column, std::size_t row) {
+    return Pixels[row * kSize + column];
+  };
+  REQUIRE((Pixel(1, 6) == 255));
+  REQUIRE((Pixel(4, 1) == 255));
+  REQUIRE((Pixel(6, 6) == 255));
+  REQUIRE((Pixel(4, 6) == 0));
+  REQUIRE((Pixel(4, 4) == 0));
+}
+
+TEST_CASE("Program reflects its active uniforms",
+  "[renderer::gl::Program][gl]")
+{
+  HiddenContext const Context;
+  if (!Context) { SKIP("No OpenGL 4.5 context available"); }
+
+  renderer::gl::Program Reflected(
+    renderer::gl::ShaderUnit<GL_VERTEX_SHADER>(R"glsl(#version 450 core
+      uniform vec4 uWeights[3];
+      uniform float uZeta;
+      uniform vec2 uAlpha;
+      void main() {
+        gl_Position = uWeights[0] + uWeights[2] + vec4(uAlpha, uZeta, 1.0);
+      })glsl"),
+    renderer::gl::ShaderUnit<GL_FRAGMENT_SHADER>(R"glsl(#version 450 core
+      out vec4 FragColour;
+      void main() { FragColour = vec4(1.0); })glsl"));
+  auto const Uniforms = Reflected.GetUniforms();
+  REQUIRE((Uniforms.size() == 3));
+  // Sorted by name, with the [0] of arrays trimmed
+  REQUIRE((Uniforms[0].Name == "uAlpha"));
+  REQUIRE((Uniforms[0].Type == GL_FLOAT_VEC2));
+  REQUIRE((Uniforms[1].Name == "uWeights"));
+  REQUIRE((Uniforms[1].Type == GL_FLOAT_VEC4));
+  REQUIRE((Uniforms[1].Size == 3));
+  REQUIRE((Uniforms[2].Name == "uZeta"));
+  REQUIRE((Reflected.FindUniform("uWeights[0]")->GetLocation()
+           == Uniforms[1].Location));
+  REQUIRE_FALSE(Reflected.FindUniform("uMissing").has_value());
+  REQUIRE_THROWS_AS(
+    Reflected.GetUniformHandle("uMissing"), renderer::UniformError);
+
+  auto const Alpha = Reflected.GetUniformHandle("uAlpha");
+  REQUIRE_NOTHROW(Reflected.SetUniform<2, float>(Alpha, 1.0F, 2.0F));
+#ifndef NDEBUG
+  // Debug builds check the C++ type against the GLSL declaration
+  REQUIRE_THROWS_AS(
+    (Reflected.SetUniform<3, float>(Alpha, 1.0F, 2.0F, 3.0F)),
+    renderer::UniformError);
+  REQUIRE_THROWS_AS(
+    (Reflected.SetUniform<2, int>(Alpha, 1, 2)), renderer::UniformError);
+#endif
+}
+
+TEST_CASE("Program skips uploads of unchanged uniform values",
+  "[renderer::gl::Program][gl]")
+{
+  HiddenContext const Context;
+  if (!Context) { SKIP("No OpenGL 4.5 context available"); }
+
+  renderer::gl::Program Shadowed(
+    renderer::gl::ShaderUnit<GL_VERTEX_SHADER>(R"glsl(#version 450 core
+      uniform vec2 uOffset;
+      void main() { gl_Position = vec4(uOffset, 0.0, 1.0); })glsl"),
+    renderer::gl::ShaderUnit<GL_FRAGMENT_SHADER>(R"glsl(#version 450 core
+      out vec4 FragColour;
+      void main() { FragColour = vec4(1.0); })glsl"));
+  auto const Offset = Shadowed.GetUniformHandle("uOffset");
+  auto const Collect = [&] {
+    renderer::FrameStatistics Statistics;
+    Shadowed.CollectStatistics(Statistics);
+    return Statistics;
+  };
+  auto const Uploaded = [&] {
+    std::array<float, 2> Value{};
+    glGetUniformfv(
+      Shadowed.GetProgramID(), Offset.GetLocation(), Value.data());
+    return Value;
+  };
+
+  Shadowed.SetUniform<2, float>(Offset, 0.5F, 0.25F);
+  Shadowed.SetUniform<2, float>(Offset, 0.5F, 0.25F);
+  auto Statistics = Collect();
+  REQUIRE((Statistics.UniformUploads == 1));
+  REQUIRE((Statistics.UniformUploadsElided == 1));
+  REQUIRE((Uploaded() == std::array{ 0.5F, 0.25F }));
+
+  // Collecting reset the counters
+  Statistics = Collect();
+  REQUIRE((Statistics.UniformUploads == 0));
+  REQUIRE((Statistics.UniformUploadsElided == 0));
+
+  Shadowed.SetUniform<2, float>(Offset, 0.5F, -1.0F);
+  Statistics = Collect();
+  REQUIRE((Statistics.UniformUploads == 1));
+  REQUIRE((Statistics.UniformUploadsElided == 0));
+  REQUIRE((Uploaded() == std::array{ 0.5F, -1.0F }));
+
+  // A raw GL call behind the program's back needs the shadows dropped
+  glProgramUniform2f(
+    Shadowed.GetProgramID(), Offset.GetLocation(), 0.0F, 0.0F);
+  Shadowed.InvalidateUniformShadows();
+  Shadowed.SetUniform<2, float>(Offset, 0.5F, -1.0F);
+  Statistics = Collect();
+  REQUIRE((Statistics.UniformUploads == 1));
+  REQUIRE((Statistics.UniformUploadsElided == 0));
+  REQUIRE((Uploaded() == std::array{ 0.5F, -1.0F }));
+}
+
+TEST_CASE("ProgramBinaryCache round-trips and rejects corrupt entries",
+  "[renderer::gl::ProgramBinaryCache][gl]")
+{
+  HiddenContext const Context;
+  if (!Context) { SKIP("No OpenGL 4.5 context available"); }
+
+  auto const Directory =
+    std::filesystem::temp_directory_path() / "renderer-program-cache-test";
+  std::filesystem::remove_all(Directory);
+  renderer::gl::ProgramBinaryCache const Cache(Directory);
+  if (!Cache.IsEnabled()) { SKIP("The driver offers no binary formats"); }
+
+  constexpr std::string_view kVertex = R"glsl(#version 450 core
+    uniform vec2 uOffset;
+    void main() { gl_Position = vec4(uOffset, 0.0, 1.0); })glsl";
+  constexpr std::string_view kFragment = R"glsl(#version 450 core
+    out vec4 FragColour;
+    void main() { FragColour = vec4(1.0); })glsl";
+  auto const Key = Cache.GetKey({ kVertex, kFragment });
+  REQUIRE_FALSE(Cache.Load(Key).has_value());
+  renderer::gl::Program const Built{
+    renderer::gl::ShaderUnit<GL_VERTEX_SHADER>{ kVertex },
+    renderer::gl::ShaderUnit<GL_FRAGMENT_SHADER>{ kFragment }
+  };
+  Cache.Store(Key, Built);
+  auto const Loaded = Cache.Load(Key);
+  REQUIRE(Loaded.has_value());
+  REQUIRE((Loaded->GetUniforms().size() == 1));
+  REQUIRE((Loaded->GetUniforms()[0].Name == "uOffset"));
+
+  auto const Entry = std::filesystem::directory_iterator(Directory)->path();
+  auto const Rewrite = [&](std::uint64_t magic, std::uint32_t size) {
+    std::fstream File(Entry, std::ios::binary | std::ios::in | std::ios::out);
+    // Magic, key, format and size, as the cache writes them
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    File.write(reinterpret_cast<char const *>(&magic), sizeof(magic));
+    File.seekp(2 * sizeof(std::uint64_t) + sizeof(std::uint32_t));
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    File.write(reinterpret_cast<char const *>(&size), sizeof(size));
+  };
+  // A size beyond the end of the file is rejected before allocating, and
+  // the entry is removed
+  std::uint64_t Magic{};
+  std::ifstream(Entry, std::ios::binary)
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    .read(reinterpret_cast<char *>(&Magic), sizeof(Magic));
+  Rewrite(Magic, std::numeric_limits<std::uint32_t>::max());
+  REQUIRE_FALSE(Cache.Load(Key).has_value());
+  REQUIRE_FALSE(std::filesystem::exists(Entry));
+
+  // So is a foreign file under the entry's name
+  Cache.Store(Key, Built);
+  Rewrite(~Magic, 16);
+  REQUIRE_FALSE(Cache.Load(Key).has_value());
+  REQUIRE_FALSE(std::filesystem::exists(Entry));
+  std::filesystem::remove_all(Directory);
+}
+
+TEST_CASE("PendingProgram links in the background",
+  "[renderer::gl::PendingProgram][gl]")
+{
+  HiddenContext const Context;
+  if (!Context) { SKIP("No OpenGL 4.5 context available"); }
+
+  constexpr std::string_view kVertex = R"glsl(#version 450 core
+    uniform vec2 uOffset;
+    void main() { gl_Position = vec4(uOffset, 0.0, 1.0); })glsl";
+  constexpr std::string_view kFragment = R"glsl(#version 450 core
+    out vec4 FragColour;
+    void main() { FragColour = vec4(1.0); })glsl";
+  renderer::gl::PendingProgram Pending(
+    { { GL_VERTEX_SHADER, kVertex }, { GL_FRAGMENT_SHADER, kFragment } });
+  bool Listed = false;
+  GLint ExtensionCount{};
+  glGetIntegerv(GL_NUM_EXTENSIONS, &ExtensionCount);
+  for (GLint Index = 0; Index < ExtensionCount; ++Index) {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    std::string_view const Extension{ reinterpret_cast<char const *>(
+      glGetStringi(GL_EXTENSIONS, static_cast<GLuint>(Index))) };
+    Listed = Listed || Extension == "GL_KHR_parallel_shader_compile"
+             || Extension == "GL_ARB_parallel_shader_compile";
+  }
+  REQUIRE((renderer::gl::SupportsParallelShaderCompile() == Listed));
+  auto const Deadline =
+    std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while (!Pending.IsReady() && std::chrono::steady_clock::now() < Deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  REQUIRE(Pending.IsReady());
+  auto const Linked = Pending.Get();
+  REQUIRE_FALSE(Pending.IsValid());
+  GLint Status{};
+  glGetProgramiv(Linked.GetProgramID(), GL_LINK_STATUS, &Status);
+  REQUIRE((Status == GL_TRUE));
+  REQUIRE(Linked.FindUniform("uOffset").has_value());
+  REQUIRE_THROWS_AS(Pending.Get(), renderer::CompilationError);
+
+  // The compile error of the failing unit comes out of Get
+  renderer::gl::PendingProgram Broken(
+    { { GL_VERTEX_SHADER, "#version 450 core\nvoid main() {" },
+      { GL_FRAGMENT_SHADER, kFragment } });
+  REQUIRE_THROWS_AS(Broken.Get(), renderer::CompilationError);
+  REQUIRE_FALSE(Broken.IsValid());
+}
+
+TEST_CASE("ProgramPermutations compiles each define set once",
+  "[renderer::gl::ProgramPermutations][gl]")
+{
+  HiddenContext const Context;
+  if (!Context) { SKIP("No OpenGL 4.5 context available"); }
+
+  using renderer::gl::ShaderDefines;
+  renderer::gl::ProgramPermutations Permutations(
+    { { GL_VERTEX_SHADER, R"glsl(#version 450 core
+        void main() { gl_Position = vec4(0.0, 0.0, 0.0, 1.0); })glsl" },
+      { GL_FRAGMENT_SHADER, R"glsl(#version 450 core
+        out vec4 FragColour;
+        #ifdef TINTED
+        uniform vec4 uTint;
+        void main() { FragColour = uTint; }
+        #else
+        void main() { FragColour = vec4(BRIGHTNESS); }
+        #endif)glsl" } });
+
+  ShaderDefines const Plain{ { "BRIGHTNESS", "1.0" } };
+  ShaderDefines Tinted{ { "TINTED" } };
+  Tinted.Set("BRIGHTNESS", "1.0");
+  auto &PlainProgram = Permutations.Get(Plain);
+  REQUIRE_FALSE(PlainProgram.FindUniform("uTint").has_value());
+  // An equal set built in another order finds the same program
+  ShaderDefines Reordered{ { "BRIGHTNESS", "0.5" } };
+  Reordered.Set("BRIGHTNESS", "1.0");
+  REQUIRE((&Permutations.Get(Reordered) == &PlainProgram));
+  REQUIRE((Permutations.Size() == 1));
+
+  Permutations.Prepare(Tinted);
+  REQUIRE((Permutations.Size() == 2));
+  auto const Deadline =
+    std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  auto *TintedProgram = Permutations.TryGet(Tinted);
+  while (TintedProgram == nullptr
+         && std::chrono::steady_clock::now() < Deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    TintedProgram = Permutations.TryGet(Tinted);
+  }
+  REQUIRE((TintedProgram != nullptr));
+  REQUIRE((TintedProgram != &PlainProgram));
+  REQUIRE(TintedProgram->FindUniform("uTint").has_value());
+  REQUIRE((&Permutations.Get(Tinted) == TintedProgram));
+
+  // A failed permutation is dropped, so it can be requested again
+  REQUIRE_THROWS_AS(
+    Permutations.Get(ShaderDefines{}), renderer::CompilationError);
+  REQUIRE((Permutations.Size() == 2));
+  REQUIRE_THROWS_AS(
+    Permutations.Get(ShaderDefines{}), renderer::CompilationError);
+}
+
+TEST_CASE("ProgramPipeline draws with separable stages",
+  "[renderer::gl::ProgramPipeline][gl]")
+{
+  HiddenContext const Context;
+  if (!Context) { SKIP("No OpenGL 4.5 context available"); }
+
+  static constexpr GLsizei kSize = 4;
+  renderer::test::RenderTarget const Target(kSize, GL_RGBA8);
+  GLuint VertexArray{};
+  glCreateVertexArrays(1, &VertexArray);
+  glBindVertexArray(VertexArray);
+
+  using renderer::gl::StageProgram;
+  // One triangle covering the whole viewport
+  auto const Vertex = StageProgram::Create<GL_VERTEX_SHADER>(
+    R"glsl(#version 450 core
+    out gl_PerVertex { vec4 gl_Position; };
+    void main()
+    {
+      vec2 Corner = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+      gl_Position = vec4(Corner * 2.0 - 1.0, 0.0, 1.0);
+    })glsl");
+  constexpr std::string_view kFragment = R"glsl(#version 450 core
+    uniform vec4 uColour;
+    out vec4 FragColour;
+    void main() { FragColour = uColour; })glsl";
+  auto Fragment = StageProgram::Create<GL_FRAGMENT_SHADER>(kFragment);
+  Fragment.GetProgram().SetUniform<4, float>(
+    "uColour", 0.0F, 1.0F, 0.0F, 1.0F);
+
+  renderer::gl::ProgramPipelineCache Pipelines;
+  auto &Pipeline = Pipelines.Get(Vertex, Fragment);
+  REQUIRE((&Pipelines.Get(Fragment, Vertex) == &Pipeline));
+  REQUIRE_NOTHROW(Pipeline.Validate());
+  Target.Clear();
+  Pipeline.Bind();
+  glDrawArrays(GL_TRIANGLES, 0, 3);
+  auto const Pixels = Target.ReadPixels();
+  auto const Pixel = std::span(Pixels).subspan(4 * (kSize + 1), 4);
+  REQUIRE(std::ranges::equal(Pixel, std::array{ 0, 255, 0, 255 }));
+
+  // A replacement fragment program may reuse the destroyed program's name,
+  // but must not reuse the pipeline built for it
+  auto const Replaced = Fragment.GetProgram().GetSerial();
+  Fragment = StageProgram::Create<GL_FRAGMENT_SHADER>(kFragment);
+  REQUIRE((&Pipelines.Get(Vertex, Fragment) != &Pipeline));
+  REQUIRE((Pipelines.Size() == 2));
+  // Evicting the replaced program releases only the pipeline it was in
+  REQUIRE((Pipelines.Evict(Replaced) == 1));
+  REQUIRE((Pipelines.Size() == 1));
+  REQUIRE((Pipelines.Evict(Fragment) == 1));
+  REQUIRE((Pipelines.Size() == 0));
+
+  glBindProgramPipeline(0);
+  glBindVertexArray(0);
+  glDeleteVertexArrays(1, &VertexArray);
+}